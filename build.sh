@@ -1,21 +1,66 @@
 #! /bin/bash
 
+#native tools
+if [[ "$1" == "tools" ]]; then
+    echo ">>> Building native tools..."
+
+    mkdir -p ./build/tools
+
+    # C++17 compiler, Boost 1.70+ (Beast, Interprocess, MultiIndex, Preprocessor)
+    # every tools/<tool>.cpp is built to build/tools/<tool>
+    for src in ./tools/*.cpp; do
+        tool=$(basename $src .cpp)
+        g++ -std=c++17 -O2 -I./contracts/waxlabs/include/ -o ./build/tools/$tool $src -pthread || exit 1
+    done
+    exit 0
+fi
+
 #contract
 if [[ "$1" == "waxlabs" ]]; then
     contract=waxlabs
+elif [[ "$1" == "decidemock" ]]; then
+    contract=decidemock
 else
     echo "need contract"
     exit 0
 fi
 
-echo ">>> Building $contract contract..."
+#variant
+if [[ "$2" == "" || "$2" == "production" ]]; then
+    variant=production
+    outdir=./build
+    flags=""
+elif [[ "$2" == "maintenance" ]]; then
+    variant=maintenance
+    outdir=./build/maintenance
+    flags="-DWAXLABS_MAINTENANCE"
+elif [[ "$2" == "trace" ]]; then
+    variant=trace
+    outdir=./build/trace
+    flags="-DWAXLABS_TRACE_ROWS"
+else
+    echo "unknown variant, use production, maintenance or trace"
+    exit 0
+fi
+
+echo ">>> Building $contract contract ($variant)..."
 
-# eosio.cdt v1.7
+mkdir -p $outdir
+
+# Antelope CDT v3.0+ (action return values, eosio::read_only actions)
 # -contract=<string>       - Contract name
 # -o=<string>              - Write output to <file>
 # -abigen                  - Generate ABI
 # -I=<string>              - Add directory to include search path
 # -L=<string>              - Add directory to library search path
 # -R=<string>              - Add a resource path for inclusion
+# -D<macro>                - Define a preprocessor macro (WAXLABS_MAINTENANCE adds the wipe* actions,
+#                            WAXLABS_TRACE_ROWS prints shared row accesses to the action console)
+
+#only contracts with ricardian resources pass -R
+resources=""
+if [[ -d ./contracts/$contract/resources ]]; then
+    resources="-R=./contracts/$contract/resources"
+fi
 
-eosio-cpp -I="./contracts/$contract/include/" -R="./contracts/$contract/resources" -o="./build/$contract.wasm" -contract="$contract" -abigen ./contracts/$contract/src/$contract.cpp
+cdt-cpp $flags -I="./contracts/$contract/include/" $resources -o="$outdir/$contract.wasm" -contract="$contract" -abigen ./contracts/$contract/src/$contract.cpp
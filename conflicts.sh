@@ -0,0 +1,88 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+# requires a load run against the trace build:
+#   ./build.sh waxlabs trace && deploy build/trace/ && ./loadgen.sh waxlabs ...
+#
+# a row conflicts when it is written by one user pipeline and read or written by another,
+# parallel execution has to serialize every pair of transactions sharing such a row
+
+rows=./build/loadgen/rows.log
+report=./build/loadgen/conflicts.md
+
+if [[ ! -s $rows ]]; then
+    echo "no row accesses in $rows, run loadgen.sh against the trace build first"
+    exit 0
+fi
+
+echo ">>> Writing $contract write-set conflict report to $report..."
+
+echo "# $contract write-set conflicts" > $report
+echo "" >> $report
+echo "$(cut -d' ' -f1 $rows | sort -u | wc -l) users, $(wc -l < $rows) row accesses" >> $report
+
+#rows written by at least one user and accessed by more than one
+echo "" >> $report
+echo "## Conflicting rows" >> $report
+echo "" >> $report
+echo "| table | scope | key | writer users | accessing users | actions |" >> $report
+echo "|---|---|---|---|---|---|" >> $report
+awk '
+    {
+        row = $4 " " $5 " " $6
+        if (!((row, $1) in users)) { users[row, $1] = 1; accessors[row]++ }
+        if ($3 == "W" && !((row, $1) in writers)) { writers[row, $1] = 1; writer_count[row]++ }
+        if (!((row, $2) in seen)) { seen[row, $2] = 1; actions[row] = actions[row] (actions[row] == "" ? "" : ", ") $2 }
+    }
+    END {
+        for (row in accessors) {
+            if (writer_count[row] > 0 && accessors[row] > 1) {
+                split(row, f, " ")
+                print accessors[row], "| " f[1] " | " f[2] " | " f[3] " | " writer_count[row] " | " accessors[row] " | " actions[row] " |"
+            }
+        }
+    }' $rows | sort -n -r | cut -d' ' -f2- >> $report
+
+#actions that can never run in parallel with each other, because they share a conflicting row
+echo "" >> $report
+echo "## Conflicting actions" >> $report
+echo "" >> $report
+echo "| action | conflicts with | through |" >> $report
+echo "|---|---|---|" >> $report
+awk '
+    {
+        row = $4 " " $5 " " $6
+        if ($3 == "W") { written[row] = 1; writes[row, $2] = 1 }
+        if (!((row, $2) in first_user)) { first_user[row, $2] = $1 }
+        if (!((row, $2, $1) in action_users)) { action_users[row, $2, $1] = 1; action_user_count[row, $2]++ }
+        names[$2] = 1
+    }
+    END {
+        for (a in names) {
+            with = ""; through = ""
+            for (b in names) {
+                for (row in written) {
+                    if (!((row, a) in first_user) || !((row, b) in first_user) || !((row, a) in writes || (row, b) in writes)) {
+                        continue
+                    }
+                    #the two actions must come from different users
+                    if (action_user_count[row, a] > 1 || action_user_count[row, b] > 1 || first_user[row, a] != first_user[row, b]) {
+                        with = with (with == "" ? "" : ", ") b
+                        split(row, f, " ")
+                        if (index(through, f[1]) == 0) { through = through (through == "" ? "" : ", ") f[1] }
+                        break
+                    }
+                }
+            }
+            if (with != "") { print "| " a " | " with " | " through " |" }
+        }
+    }' $rows | sort >> $report
+
+cat $report
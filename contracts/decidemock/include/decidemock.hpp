@@ -0,0 +1,127 @@
+// Minimal stand-in for the Telos Decide contract, for local testing and benchmarking of WAX Labs.
+// Only implements the actions and tables waxlabs depends on. Deploy to an account named decide.
+//
+// @contract decidemock
+// @version v0.1.0
+
+#include <eosio/eosio.hpp>
+#include <eosio/asset.hpp>
+#include <eosio/action.hpp>
+
+using namespace std;
+using namespace eosio;
+
+CONTRACT decidemock : public contract
+{
+    public:
+
+    decidemock(name self, name code, datastream<const char*> ds) : contract(self, code, ds) {}
+
+    //======================== mock actions ========================
+
+    //create or update a treasury
+    //post: treasury.supply == supply, treasury.max_supply == max_supply
+    //auth: self
+    ACTION settreasury(name manager, asset supply, asset max_supply);
+
+    //set final results of a ballot in voting, replaces castvote
+    //pre: ballot.status == voting
+    //auth: self
+    ACTION setresults(name ballot_name, map<name, asset> results, uint32_t total_voters);
+
+    //======================== decide actions ========================
+
+    //create a new ballot
+    //post: ballot.status == setup
+    //auth: publisher
+    ACTION newballot(name ballot_name, name category, name publisher,
+        symbol treasury_symbol, name voting_method, vector<name> initial_options);
+
+    //edit ballot details
+    //pre: ballot.status == setup
+    //auth: publisher
+    ACTION editdetails(name ballot_name, string title, string description, string content);
+
+    //toggle a ballot setting
+    //pre: ballot.status == setup
+    //auth: publisher
+    ACTION togglebal(name ballot_name, name setting_name);
+
+    //open a ballot for voting
+    //pre: ballot.status == setup, end_time > now
+    //post: ballot.status == voting
+    //auth: publisher
+    ACTION openvoting(name ballot_name, time_point_sec end_time);
+
+    //cancel a ballot in voting
+    //pre: ballot.status == voting
+    //post: ballot.status == cancelled
+    //auth: publisher
+    ACTION cancelballot(name ballot_name, string memo);
+
+    //close a ballot, optionally broadcasting its results
+    //pre: ballot.status == voting, now >= ballot.end_time
+    //post: ballot.status == closed
+    //auth: publisher
+    ACTION closevoting(name ballot_name, bool broadcast);
+
+    //notify publisher of ballot results
+    //auth: self
+    ACTION broadcast(name ballot_name, map<name, asset> final_results, uint32_t total_voters);
+
+    //======================== contract tables ========================
+
+    //treasuries table, same layout as decide
+    //scope: self
+    TABLE treasury {
+        asset supply;
+        asset max_supply;
+        name access;
+        name manager;
+        string title;
+        string description;
+        string icon;
+        uint32_t voters;
+        uint32_t delegates;
+        uint32_t committees;
+        uint32_t open_ballots;
+        bool locked;
+        name unlock_acct;
+        name unlock_auth;
+        map<name, bool> settings;
+
+        uint64_t primary_key() const { return supply.symbol.code().raw(); }
+        EOSLIB_SERIALIZE(treasury,
+            (supply)(max_supply)(access)(manager)
+            (title)(description)(icon)
+            (voters)(delegates)(committees)(open_ballots)
+            (locked)(unlock_acct)(unlock_auth)(settings))
+    };
+    typedef multi_index<name("treasuries"), treasury> treasuries_table;
+
+    //ballots table, subset of decide ballot
+    //scope: self
+    TABLE ballot {
+        name ballot_name;
+        name category;
+        name publisher;
+        name status; //setup, voting, cancelled, closed
+        string title;
+        string description;
+        string content;
+        symbol treasury_symbol;
+        name voting_method;
+        map<name, asset> options;
+        uint32_t total_voters = 0;
+        map<name, bool> settings;
+        time_point_sec begin_time;
+        time_point_sec end_time;
+
+        uint64_t primary_key() const { return ballot_name.value; }
+        EOSLIB_SERIALIZE(ballot, (ballot_name)(category)(publisher)(status)
+            (title)(description)(content)(treasury_symbol)(voting_method)
+            (options)(total_voters)(settings)(begin_time)(end_time))
+    };
+    typedef multi_index<name("ballots"), ballot> ballots_table;
+
+};
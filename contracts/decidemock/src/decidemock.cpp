@@ -0,0 +1,238 @@
+#include "../include/decidemock.hpp"
+
+//======================== mock actions ========================
+
+ACTION decidemock::settreasury(name manager, asset supply, asset max_supply)
+{
+    //authenticate
+    require_auth(get_self());
+
+    //validate
+    check(supply.symbol == max_supply.symbol, "symbol mismatch");
+    check(supply.amount >= 0 && supply <= max_supply, "invalid supply");
+
+    //open treasuries table, find treasury
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto trs_itr = treasuries.find(supply.symbol.code().raw());
+
+    if (trs_itr == treasuries.end()) {
+        //emplace new treasury
+        treasuries.emplace(get_self(), [&](auto& col) {
+            col.supply = supply;
+            col.max_supply = max_supply;
+            col.access = name("public");
+            col.manager = manager;
+            col.title = "Mock Treasury";
+            col.voters = 0;
+            col.delegates = 0;
+            col.committees = 0;
+            col.open_ballots = 0;
+            col.locked = false;
+            col.unlock_acct = manager;
+            col.unlock_auth = name("active");
+        });
+    } else {
+        //update treasury
+        treasuries.modify(trs_itr, same_payer, [&](auto& col) {
+            col.supply = supply;
+            col.max_supply = max_supply;
+            col.manager = manager;
+        });
+    }
+}
+
+ACTION decidemock::setresults(name ballot_name, map<name, asset> results, uint32_t total_voters)
+{
+    //authenticate
+    require_auth(get_self());
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //validate
+    check(bal.status == name("voting"), "ballot must be in voting status");
+
+    for (auto& res : results) {
+        check(bal.options.count(res.first), "option not found on ballot");
+        check(res.second.symbol == bal.treasury_symbol, "result symbol mismatch");
+    }
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        for (auto& res : results) {
+            col.options[res.first] = res.second;
+        }
+        col.total_voters = total_voters;
+    });
+}
+
+//======================== decide actions ========================
+
+ACTION decidemock::newballot(name ballot_name, name category, name publisher,
+    symbol treasury_symbol, name voting_method, vector<name> initial_options)
+{
+    //authenticate
+    require_auth(publisher);
+
+    //open tables
+    treasuries_table treasuries(get_self(), get_self().value);
+    ballots_table ballots(get_self(), get_self().value);
+
+    //validate
+    treasuries.get(treasury_symbol.code().raw(), "treasury not found");
+    check(ballots.find(ballot_name.value) == ballots.end(), "ballot name already exists");
+
+    //emplace new ballot
+    ballots.emplace(publisher, [&](auto& col) {
+        col.ballot_name = ballot_name;
+        col.category = category;
+        col.publisher = publisher;
+        col.status = name("setup");
+        col.treasury_symbol = treasury_symbol;
+        col.voting_method = voting_method;
+        for (auto& opt : initial_options) {
+            col.options[opt] = asset(0, treasury_symbol);
+        }
+    });
+}
+
+ACTION decidemock::editdetails(name ballot_name, string title, string description, string content)
+{
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("setup"), "ballot must be in setup status");
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.title = title;
+        col.description = description;
+        col.content = content;
+    });
+}
+
+ACTION decidemock::togglebal(name ballot_name, name setting_name)
+{
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("setup"), "ballot must be in setup status");
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.settings[setting_name] = !col.settings[setting_name];
+    });
+}
+
+ACTION decidemock::openvoting(name ballot_name, time_point_sec end_time)
+{
+    //open tables, get ballot and treasury
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    time_point_sec now = time_point_sec(current_time_point());
+    check(bal.status == name("setup"), "ballot must be in setup status");
+    check(end_time > now, "end time must be in the future");
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.status = name("voting");
+        col.begin_time = now;
+        col.end_time = end_time;
+    });
+
+    //update treasury
+    treasuries.modify(trs, same_payer, [&](auto& col) {
+        col.open_ballots += 1;
+    });
+}
+
+ACTION decidemock::cancelballot(name ballot_name, string memo)
+{
+    //open tables, get ballot and treasury
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("voting"), "ballot must be in voting status");
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.status = name("cancelled");
+    });
+
+    //update treasury
+    treasuries.modify(trs, same_payer, [&](auto& col) {
+        col.open_ballots -= 1;
+    });
+}
+
+ACTION decidemock::closevoting(name ballot_name, bool broadcast)
+{
+    //open tables, get ballot and treasury
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+    treasuries_table treasuries(get_self(), get_self().value);
+    auto& trs = treasuries.get(bal.treasury_symbol.code().raw(), "treasury not found");
+
+    //authenticate
+    require_auth(bal.publisher);
+
+    //validate
+    check(bal.status == name("voting"), "ballot must be in voting status");
+    check(time_point_sec(current_time_point()) >= bal.end_time, "must be past ballot end time to close");
+
+    //update ballot
+    ballots.modify(bal, same_payer, [&](auto& col) {
+        col.status = name("closed");
+    });
+
+    //update treasury
+    treasuries.modify(trs, same_payer, [&](auto& col) {
+        col.open_ballots -= 1;
+    });
+
+    if (broadcast) {
+        //send inline broadcast to self
+        action(permission_level{get_self(), name("active")}, get_self(), name("broadcast"), make_tuple(
+            ballot_name, //ballot_name
+            bal.options, //final_results
+            bal.total_voters //total_voters
+        )).send();
+    }
+}
+
+ACTION decidemock::broadcast(name ballot_name, map<name, asset> final_results, uint32_t total_voters)
+{
+    //authenticate
+    require_auth(get_self());
+
+    //open ballots table, get ballot
+    ballots_table ballots(get_self(), get_self().value);
+    auto& bal = ballots.get(ballot_name.value, "ballot not found");
+
+    //notify publisher
+    require_recipient(bal.publisher);
+}
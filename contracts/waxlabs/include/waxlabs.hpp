@@ -8,6 +8,10 @@
 #include <eosio/singleton.hpp>
 #include <eosio/asset.hpp>
 #include <eosio/action.hpp>
+#include <eosio/transaction.hpp>
+
+#include "waxlabs_fields.hpp"
+#include "waxlabs_keys.hpp"
 
 using namespace std;
 using namespace eosio;
@@ -19,8 +23,9 @@ CONTRACT waxlabs : public contract
 {
     public:
 
-    waxlabs(name self, name code, datastream<const char*> ds) : contract(self, code, ds) {}
-    ~waxlabs() {}
+    waxlabs(name self, name code, datastream<const char*> ds) : contract(self, code, ds),
+        _configs(self, self.value), _stats(self, self.value), _fundstats(self, self.value), _fundscans(self, self.value) {}
+    ~waxlabs() { flush(); }
 
     static constexpr symbol WAX_SYM = symbol("WAX", 8);
     static constexpr symbol VOTE_SYM = symbol("VOTE", 8);
@@ -36,9 +41,27 @@ CONTRACT waxlabs : public contract
     const size_t  MAX_IMGURL_LEN = 256;
     const size_t  MAX_SMALL_DESC_LEN = 80;
     const size_t  MAX_ROAD_MAP_LEN = 2048;
+    const size_t  MAX_PROFILE_NAME_LEN = 64;
+    const size_t  MAX_BIO_LEN = 1024;
+    const size_t  MAX_CONTACT_LEN = 256;
 
     const uint64_t MAX_PROPOSAL_ID = 0xFFFFFFFF;
 
+    // Maximum number of joined proposal views returned by one getprops() call.
+    const uint32_t MAX_PAGE_SIZE = 20;
+
+    // Maximum number of proposals reviewed by one reviewprops() call.
+    const size_t MAX_REVIEW_BATCH = 50;
+
+    // Number of most recent rows kept in the changes table.
+    const uint64_t CHANGE_RETENTION = 10'000;
+
+    // Number of most recent days kept in the flowdays table.
+    const uint32_t FLOW_RETENTION_DAYS = 730;
+
+    // Thresholds are stored in basis points (1/100th of a percent).
+    static constexpr uint16_t BPS_DENOMINATOR = 10'000;
+
     enum class proposal_status : uint8_t {
         drafting    = 1,
         submitted   = 2,
@@ -70,11 +93,157 @@ CONTRACT waxlabs : public contract
         return a == static_cast<uint8_t>(b);
     }
 
+    enum class change_op : uint8_t {
+        insert = 1,
+        modify = 2,
+        erase  = 3,
+    };
+
+    friend constexpr bool operator == ( const uint8_t& a, const change_op& b) {
+        return a == static_cast<uint8_t>(b);
+    }
+
+    //======================== status transitions ========================
+
+    struct proposal;
+    struct deliverable;
+
+    template<typename Status>
+    struct status_transition {
+        Status from;
+        Status to;
+    };
+
+    //every legal proposal status change. a transition missing here fails to compile at the call site.
+    static constexpr status_transition<proposal_status> PROPOSAL_TRANSITIONS[] = {
+        { proposal_status::drafting,   proposal_status::submitted },  //submitprop
+        { proposal_status::submitted,  proposal_status::approved },   //reviewprop
+        { proposal_status::submitted,  proposal_status::failed },     //reviewprop
+        { proposal_status::submitted,  proposal_status::inprogress }, //skipvoting
+        { proposal_status::approved,   proposal_status::voting },     //beginvoting
+        { proposal_status::voting,     proposal_status::inprogress }, //catch_broadcast
+        { proposal_status::voting,     proposal_status::failed },     //catch_broadcast
+        { proposal_status::drafting,   proposal_status::cancelled },  //cancelprop
+        { proposal_status::submitted,  proposal_status::cancelled },  //cancelprop
+        { proposal_status::approved,   proposal_status::cancelled },  //cancelprop
+        { proposal_status::voting,     proposal_status::cancelled },  //cancelprop
+        { proposal_status::inprogress, proposal_status::completed },  //claimfunds
+    };
+
+    //every legal deliverable status change
+    static constexpr status_transition<deliverable_status> DELIVERABLE_TRANSITIONS[] = {
+        { deliverable_status::drafting,   deliverable_status::inprogress }, //proposal activated
+        { deliverable_status::drafting,   deliverable_status::rejected },   //cancelprop
+        { deliverable_status::inprogress, deliverable_status::reported },   //submitreport
+        { deliverable_status::rejected,   deliverable_status::reported },   //submitreport
+        { deliverable_status::reported,   deliverable_status::accepted },   //reviewdeliv
+        { deliverable_status::reported,   deliverable_status::rejected },   //reviewdeliv
+        { deliverable_status::accepted,   deliverable_status::claimed },    //claimfunds
+    };
+
+    template<typename Status, size_t N>
+    static constexpr bool is_transition(const status_transition<Status> (&table)[N], Status from, Status to) {
+        for (size_t i = 0; i < N; i++) {
+            if (table[i].from == from && table[i].to == to) return true;
+        }
+        return false;
+    }
+
+    //bitmask of the given statuses, used for a single runtime membership test
+    template<typename Status, Status... statuses>
+    static constexpr uint32_t status_mask() {
+        return ((uint32_t(1) << static_cast<uint8_t>(statuses)) | ... | 0);
+    }
+
+    //stats row label for each proposal status
+    static constexpr const char* proposal_status_name(proposal_status status) {
+        switch (status) {
+            case proposal_status::drafting:   return "Proposals in drafting";
+            case proposal_status::submitted:  return "Proposals in review";
+            case proposal_status::approved:   return "Proposals approved";
+            case proposal_status::voting:     return "Proposals in voting";
+            case proposal_status::inprogress: return "Proposals in progress";
+            case proposal_status::failed:     return "Proposals failed";
+            case proposal_status::cancelled:  return "Proposals cancelled";
+            case proposal_status::completed:  return "Completed Proposals";
+        }
+        return "";
+    }
+
+    //validates prop.status is one of `from`, moves the stats count from the old to the new status
+    //and returns the new status to be written by the caller's modify().
+    template<proposal_status to, proposal_status... from>
+    uint8_t advance_proposal(const proposal& prop, const char* error_msg) {
+        static_assert(sizeof...(from) > 0, "at least one source status is required");
+        static_assert((is_transition(PROPOSAL_TRANSITIONS, from, to) && ...), "illegal proposal status transition");
+
+        check((status_mask<proposal_status, from...>() >> prop.status) & 1, error_msg);
+
+        dec_stats_count(static_cast<uint64_t>(prop.status));
+        inc_stats_count(static_cast<uint64_t>(to), proposal_status_name(to));
+        log_proposal_event(prop.proposal_id, prop.proposer, prop.status, static_cast<uint8_t>(to));
+
+        return static_cast<uint8_t>(to);
+    }
+
+    //validates deliv.status is one of `from` and returns the new status to be written by the caller's modify()
+    template<deliverable_status to, deliverable_status... from>
+    static uint8_t advance_deliverable(const deliverable& deliv, const char* error_msg) {
+        static_assert(sizeof...(from) > 0, "at least one source status is required");
+        static_assert((is_transition(DELIVERABLE_TRANSITIONS, from, to) && ...), "illegal deliverable status transition");
+
+        check((status_mask<deliverable_status, from...>() >> deliv.status) & 1, error_msg);
+
+        return static_cast<uint8_t>(to);
+    }
+
+
+    //======================== action results ========================
+    // returned through action return values so clients don't need a follow-up table read
+
+    //result of an action that changes a proposal
+    struct proposal_result {
+        uint64_t proposal_id;
+        uint8_t status;
+        asset total_requested_funds;
+        time_point_sec update_ts;
+
+        EOSLIB_SERIALIZE(proposal_result, (proposal_id)(status)(total_requested_funds)(update_ts))
+    };
+
+    //result of an action that changes a deliverable
+    struct deliverable_result {
+        uint64_t proposal_id;
+        uint64_t deliverable_id;
+        uint8_t status;
+        uint8_t proposal_status;
+        asset total_requested_funds;
+
+        EOSLIB_SERIALIZE(deliverable_result, (proposal_id)(deliverable_id)(status)(proposal_status)(total_requested_funds))
+    };
+
+    //one entry of a reviewprops() batch
+    //decision is approve, reject or skipvoting, memo is the status comment for approve and reject
+    struct proposal_review {
+        WAXLABS_MEMBERS(WAXLABS_PROPOSAL_REVIEW_PARAMS)
+
+        EOSLIB_SERIALIZE(proposal_review, WAXLABS_NAMES(WAXLABS_PROPOSAL_REVIEW_PARAMS))
+    };
+
+    //result of an action that changes an account balance
+    struct balance_result {
+        name account_owner;
+        asset balance;
+
+        EOSLIB_SERIALIZE(balance_result, (account_owner)(balance))
+    };
 
     //======================== config actions ========================
 
 
+#ifdef WAXLABS_MAINTENANCE
     //temporary action that wipes the RAM tables
+    //only compiled into the maintenance build: ./build.sh waxlabs maintenance
     // auth: _self
     ACTION wipestats();
     ACTION wipeprops(uint32_t count);
@@ -85,6 +254,7 @@ CONTRACT waxlabs : public contract
 
     ACTION wipebodies(uint32_t count);
     ACTION wipeprofiles(uint32_t count);
+#endif
 
     //initialize the contract
     //pre: config table not initialized
@@ -114,6 +284,33 @@ CONTRACT waxlabs : public contract
     //auth: admin_acct
     ACTION rmvcategory(name category_name);
 
+    //rewrite a legacy config row (double thresholds) into the basis point layout
+    //pre: config row still in legacy layout, eosio::setcode of self earlier in the same transaction.
+    //     the new code misreads the legacy row, so no action may run between the upgrade and this one.
+    //auth: self
+    ACTION migrateconf();
+
+    //rebuild the funding aggregate of one category and status from the proposals table
+    //sums up to count proposals of the bycatstat bucket per call into a fundscans row, and replaces
+    //the fundstats row once the scan reaches the end of the bucket. call again until it reports complete
+    //pre: count > 0
+    //auth: admin_acct
+    ACTION recompfunds(name category, uint8_t status, uint32_t count);
+
+    //rebuild the current proposal count of one proposer from the proposals table
+    //walks up to count proposals of the primary index per call into a countscans row, and replaces
+    //the propcounts current_count once the walk reaches the end of the table. call again until it reports complete
+    //pre: count > 0
+    //auth: admin_acct
+    ACTION recompcount(name proposer, uint32_t count);
+
+    //create the missing profileregs rows of existing profiles, starting at lower_bound
+    //registers up to count profiles per call, already registered ones are passed over without counting.
+    //prints the account to continue at, or complete at the end of the table
+    //pre: count > 0, at least one profile from lower_bound not registered yet
+    //auth: self
+    ACTION migprofiles(name lower_bound, uint32_t count);
+
     //======================== proposal actions ========================
 
     //draft a new wax labs proposal
@@ -123,116 +320,153 @@ CONTRACT waxlabs : public contract
     // description, mdbody, image_url and title must not be bigger than max_len variables
     // account must have more than
     //auth: proposer
-    ACTION draftprop(string title, string description, string mdbody, name proposer,
-        string image_url, uint32_t estimated_time, name category, string road_map);
+    [[eosio::action]] proposal_result draftprop(WAXLABS_PARAMS(WAXLABS_DRAFTPROP_PARAMS));
 
     //edit a proposal draft
     //pre: proposal.status == drafting
     //auth: proposer
-    ACTION editprop(uint64_t proposal_id, optional<string> title,
-        optional<string> description, optional<string> mdbody, optional<name> category,
-        string image_url, uint32_t estimated_time, optional<string> road_map);
+    [[eosio::action]] proposal_result editprop(WAXLABS_PARAMS(WAXLABS_EDITPROP_PARAMS));
 
     //submit a proposal draft for admin approval
     //pre: proposal.status == drafting, reviewer is set.
     //post: proposal.status == submitted
     //auth: proposer
-    ACTION submitprop(uint64_t proposal_id);
+    [[eosio::action]] proposal_result submitprop(WAXLABS_PARAMS(WAXLABS_SUBMITPROP_PARAMS));
 
     //approve or reject a submitted proposal
     //pre: proposal.status == submitted
     //post: proposal.status == approved if approved, proposal.status == failed if rejected
     //auth: admin_acct
-    ACTION reviewprop(uint64_t proposal_id, bool approve, string memo);
+    [[eosio::action]] proposal_result reviewprop(WAXLABS_PARAMS(WAXLABS_REVIEWPROP_PARAMS));
 
 
     //pass a proposal, without going through voting
     //pre: proposal.status == submitted
     //post: proposal.status == inprogress
     //auth: admin_acct
-    ACTION skipvoting(uint64_t proposal_id, string memo);
+    [[eosio::action]] proposal_result skipvoting(WAXLABS_PARAMS(WAXLABS_SKIPVOTING_PARAMS));
+
+    //review a batch of submitted proposals, decision is approve, reject or skipvoting
+    //funding of every skipvoting decision is checked up front, config and stats are written once
+    //pre: proposal.status == submitted for every review, reviews.size() <= MAX_REVIEW_BATCH
+    //auth: admin_acct
+    [[eosio::action]] vector<proposal_result> reviewprops(WAXLABS_PARAMS(WAXLABS_REVIEWPROPS_PARAMS));
 
     //begin voting period on a proposal
     //pre: proposal.status == drafting
     //auth: proposer
-    ACTION beginvoting(uint64_t proposal_id, name ballot_name);
+    [[eosio::action]] proposal_result beginvoting(WAXLABS_PARAMS(WAXLABS_BEGINVOTING_PARAMS));
 
     //end voting period on a proposal and receive ballot results
     //pre: proposal.status == voting, now > decide::ballot.end_time
     //post: proposal.status == inprogress if passed, proposal.status == failed if failed
     //auth: proposer or admin_acct
-    ACTION endvoting(uint64_t proposal_id);
+    [[eosio::action]] proposal_result endvoting(WAXLABS_PARAMS(WAXLABS_ENDVOTING_PARAMS));
 
-    //set a reviewer for a deliverable
+    //set the default reviewer of a proposal's deliverables
+    //deliverable_id is unused, use setdreviewer to assign a single deliverable
     //auth: admin_acct
-    ACTION setreviewer(uint64_t proposal_id, uint64_t deliverable_id, name new_reviewer);
+    [[eosio::action]] proposal_result setreviewer(WAXLABS_PARAMS(WAXLABS_SETREVIEWER_PARAMS));
 
     //cancel proposal
     //pre: proposal.status == drafing || submitted || approved || voting
     //post: proposal.status == cancelled
     //auth: proposer
-    ACTION cancelprop(uint64_t proposal_id, string memo);
+    [[eosio::action]] proposal_result cancelprop(WAXLABS_PARAMS(WAXLABS_CANCELPROP_PARAMS));
 
     //delete proposal in terminal state
     //pre: proposal.status == failed || cancelled || completed
     //auth: proposer or admin_acct
-    ACTION deleteprop(uint64_t proposal_id);
+    [[eosio::action]] proposal_result deleteprop(WAXLABS_PARAMS(WAXLABS_DELETEPROP_PARAMS));
 
     //======================== deliverable actions ========================
 
     //adds a new deliverable to a proposal
     //pre: proposal.status == drafting
     //auth: proposer
-    ACTION newdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset requested_amount, name recipient, string small_description, uint32_t days_to_complete);
+    [[eosio::action]] deliverable_result newdeliv(WAXLABS_PARAMS(WAXLABS_NEWDELIV_PARAMS));
 
     //remove a milestone from a proposal
     //pre: proposal.status == drafting
     //auth: proposer
-    ACTION rmvdeliv(uint64_t proposal_id, uint64_t deliverable_id);
+    [[eosio::action]] deliverable_result rmvdeliv(WAXLABS_PARAMS(WAXLABS_RMVDELIV_PARAMS));
 
     //edit the requested amount for a deliverable
     //pre: proposal.status == drafting
     //post: sum amount of all deliverables == proposal.total_requested_funds
     //auth: proposer
-    ACTION editdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset new_requested_amount, name new_recipient, string small_description, uint32_t days_to_complete);
+    [[eosio::action]] deliverable_result editdeliv(WAXLABS_PARAMS(WAXLABS_EDITDELIV_PARAMS));
 
     //submit a deliverable report
     //pre: proposal.status == inprogress, deliverable.status == inprogress
     //auth: proposer
-    ACTION submitreport(uint64_t proposal_id, uint64_t deliverable_id, string report);
+    [[eosio::action]] deliverable_result submitreport(WAXLABS_PARAMS(WAXLABS_SUBMITREPORT_PARAMS));
 
     //review a deliverable
     //pre: proposal.status == inprogress, deliverable.status == reported
     //auth: proposal.reviewer
-    ACTION reviewdeliv(uint64_t proposal_id, uint64_t deliverable_id, bool accept, string memo);
+    [[eosio::action]] deliverable_result reviewdeliv(WAXLABS_PARAMS(WAXLABS_REVIEWDELIV_PARAMS));
 
     //claim deliverable funding
     //pre: proposal.status == inprogress, deliverable.status == accepted
     //auth: proposer or recipient
-    ACTION claimfunds(uint64_t proposal_id, uint64_t deliverable_id);
+    [[eosio::action]] deliverable_result claimfunds(WAXLABS_PARAMS(WAXLABS_CLAIMFUNDS_PARAMS));
+
+    //set the reviewer of a single deliverable, in place of proposal.reviewer
+    //a blank new_reviewer clears the assignment and falls back to proposal.reviewer
+    //pre: deliverable.status == drafting || inprogress || reported || rejected
+    //auth: admin_acct
+    [[eosio::action]] deliverable_result setdreviewer(WAXLABS_PARAMS(WAXLABS_SETDREVIEWER_PARAMS));
 
     //======================== profile actions ========================
 
     //create a new profile
+    //pre: strings within MAX_PROFILE_NAME_LEN, MAX_BIO_LEN, MAX_IMGURL_LEN and MAX_CONTACT_LEN
     //auth: wax_account
-    ACTION newprofile(name wax_account, string full_name, string country, string bio,
-        string image_url, string website, string contact, string group_name);
+    ACTION newprofile(WAXLABS_PARAMS(WAXLABS_PROFILE_PARAMS));
 
     //edit an existing profile
+    //pre: same string limits as newprofile
     //auth: wax_account
-    ACTION editprofile(name wax_account, string full_name, string country, string bio,
-        string image_url, string website, string contact, string group_name);
+    ACTION editprofile(WAXLABS_PARAMS(WAXLABS_PROFILE_PARAMS));
 
     //remove a profile
     //auth: wax_account or admin_acct
-    ACTION rmvprofile(name wax_account);
+    ACTION rmvprofile(WAXLABS_PARAMS(WAXLABS_RMVPROFILE_PARAMS));
 
     //======================== account actions ========================
 
     //withdraw from account balance
     //pre: account.balance >= quantity
     //auth: account_owner
-    ACTION withdraw(name account_owner, asset quantity);
+    [[eosio::action]] balance_result withdraw(WAXLABS_PARAMS(WAXLABS_WITHDRAW_PARAMS));
+
+    //refund unused draft slots paid with a "draft" transfer
+    //pre: profilereg.draft_slots > 0, config.available_funds covers the refund
+    //auth: account_owner
+    ACTION refundslots(WAXLABS_PARAMS(WAXLABS_REFUNDSLOTS_PARAMS));
+
+    //======================== event actions ========================
+    // notify-only actions sent inline by the contract itself. they write no state,
+    // indexers read the before and after values from the action traces.
+
+    //proposal status changed. old_status is 0 when the proposal was just drafted.
+    //auth: self
+    ACTION logpropstat(uint64_t proposal_id, name proposer, uint8_t old_status, uint8_t new_status);
+
+    //deliverable status changed by a report, review or claim
+    //auth: self
+    ACTION logdelvstat(uint64_t proposal_id, uint64_t deliverable_id, uint8_t old_status, uint8_t new_status,
+        asset requested, name recipient);
+
+    //account balance changed. reason is deposit, withdraw, claim, draftfee or ballotfee
+    //auth: self
+    ACTION logbalance(name account_owner, asset old_balance, asset new_balance, name reason);
+
+    //config funds changed by a transfer or refund that bypasses account balances. reason is
+    //fund, draft or slotrefund, all of them change available_funds. the funds are the new config values.
+    //auth: self
+    ACTION logfunds(name account, asset quantity, asset available_funds, asset deposited_funds, name reason);
 
     //======================== notification handlers ========================
 
@@ -246,6 +480,10 @@ CONTRACT waxlabs : public contract
 
     //======================== functions ========================
 
+    //checks every profile string against its MAX_*_LEN limit
+    void check_profile_strings(const string& full_name, const string& country, const string& bio,
+        const string& image_url, const string& website, const string& contact, const string& group_name);
+
     // increments (creates if not found) stat count both total and current.
     void inc_stats_count(uint64_t key, string val_name);
 
@@ -254,17 +492,42 @@ CONTRACT waxlabs : public contract
     // if dec_total is true also decrements total.
     void dec_stats_count(uint64_t key, bool dec_total = false);
 
-    //subtracts amount from balance
-    void sub_balance(name account_owner, asset quantity);
+    //removes a proposal from the funding aggregate of its current category and status
+    //call before modifying category, status, total_requested_funds or remaining_funds
+    //an aggregate that does not hold the proposal is clamped at zero and its drift counted, until recompfunds rebuilds it
+    void sub_funding(const proposal& prop);
+
+    //adds a proposal to the funding aggregate of its current category and status
+    //call after modifying category, status, total_requested_funds or remaining_funds
+    void add_funding(const proposal& prop);
+
+    //subtracts amount from balance, returns the new balance
+    asset sub_balance(name account_owner, asset quantity, name reason);
+
+    //adds amount to balance, returns the new balance
+    asset add_balance(name account_owner, asset quantity, name reason);
+
+    //sends an inline logpropstat event
+    void log_proposal_event(uint64_t proposal_id, name proposer, uint8_t old_status, uint8_t new_status);
+
+    //sends an inline logdelvstat event
+    void log_deliverable_event(uint64_t proposal_id, const deliverable& deliv, uint8_t new_status);
+
+    //sends an inline logbalance event
+    void log_balance_event(name account_owner, asset old_balance, asset new_balance, name reason);
+
+    //sends an inline logfunds event with the current config funds
+    void log_funds_event(name account, asset quantity, name reason);
 
-    //adds amount to balance
-    void add_balance(name account_owner, asset quantity);
+    //returns the DRAFT_COST of slots prepaid draft slots to account_owner from available funds
+    //the caller clears the slots on the profilereg row
+    void refund_draft_slots(name account_owner, uint32_t slots);
 
     //returns true if vote passed quorum threshold
-    // bool did_pass_quorum_thresh();
+    bool did_pass_quorum_thresh(const asset& total_votes, const asset& supply, uint16_t quorum_threshold_bps);
 
     //returns true if vote passed yes threshold
-    // bool did_pass_yes_thresh();
+    bool did_pass_yes_thresh(const asset& yes_votes, const asset& total_votes, uint16_t yes_threshold_bps);
 
     //sets a comment for a proposal
     void set_pcomment(uint64_t proposal_id, string status_comment, name payer);
@@ -284,11 +547,90 @@ CONTRACT waxlabs : public contract
 
         auto primary_key()const { return key; }
 
-        EOSLIB_SERIALIZE(stat, (key)(val_name)(current_count)(total_count))
+        EOSLIB_SERIALIZE(stat, WAXLABS_STAT_FIELDS)
     };
     typedef eosio::multi_index<
         name("stats"), stat> stats;
 
+    //funding aggregates table
+    //scope: self
+    //one row per category and status holding proposals, kept in step with the proposals table by
+    //sub_funding() and add_funding(). paid funds of a category are requested - remaining over inprogress and completed
+    //a contract upgraded with existing proposals runs recompfunds on every bucket, until then sub_funding() clamps and counts drift
+    TABLE fundstat {
+        uint8_t category;
+        uint8_t status;
+        uint32_t proposals = 0; //number of proposals
+        asset requested = asset(0, WAX_SYM); //sum of total_requested_funds
+        asset remaining = asset(0, WAX_SYM); //sum of remaining_funds
+        uint32_t drift = 0; //removals the row did not hold and clamped at zero, cleared by recompfunds
+
+        // Same encoding as bycatstat with proposal_id 0
+        uint64_t primary_key() const { return waxlabs_keys::category_status(category, status, 0); }
+        EOSLIB_SERIALIZE(fundstat, (category)(status)(proposals)(requested)(remaining)(drift))
+    };
+    typedef multi_index<name("fundstats"), fundstat> fundstats_table;
+
+    //funding aggregate scans table
+    //scope: self
+    //one row per recompfunds scan in progress, holding the sums of the bucket proposals below next_id.
+    //sub_funding() and add_funding() adjust it for proposals the scan has passed
+    TABLE fundscan {
+        uint8_t category;
+        uint8_t status;
+        uint64_t next_id = 0; //first proposal_id not summed yet
+        uint32_t proposals = 0; //number of proposals summed
+        asset requested = asset(0, WAX_SYM); //sum of total_requested_funds
+        asset remaining = asset(0, WAX_SYM); //sum of remaining_funds
+
+        // Same encoding as fundstats
+        uint64_t primary_key() const { return waxlabs_keys::category_status(category, status, 0); }
+        EOSLIB_SERIALIZE(fundscan, (category)(status)(next_id)(proposals)(requested)(remaining))
+    };
+    typedef multi_index<name("fundscans"), fundscan> fundscans_table;
+
+    //proposal counts table
+    //scope: self
+    TABLE propcount {
+        name proposer;
+        uint32_t current_count = 0; //proposals not deleted
+        uint32_t total_count = 0; //proposals ever drafted
+
+        uint64_t primary_key() const { return proposer.value; }
+        EOSLIB_SERIALIZE(propcount, (proposer)(current_count)(total_count))
+    };
+    typedef multi_index<name("propcounts"), propcount> propcounts_table;
+
+    //proposal count scans table
+    //scope: self
+    //one row per recompcount scan in progress, holding the proposer's proposals below next_id.
+    //deleteprop adjusts it for proposals the scan has passed, new drafts are always ahead of it
+    TABLE countscan {
+        name proposer;
+        uint64_t next_id = 0; //first proposal_id not counted yet
+        uint32_t proposals = 0; //proposals of proposer counted
+
+        uint64_t primary_key() const { return proposer.value; }
+        EOSLIB_SERIALIZE(countscan, (proposer)(next_id)(proposals))
+    };
+    typedef multi_index<name("countscans"), countscan> countscans_table;
+
+    //funding flow table
+    //scope: self
+    //one row per day with funds moved that day, rows older than FLOW_RETENTION_DAYS are pruned
+    TABLE flowday {
+        uint32_t day; //days since epoch (UTC)
+        asset deposited = asset(0, WAX_SYM); //transfers into account balances
+        asset funded = asset(0, WAX_SYM); //transfers into available funds ("fund" and "draft" memo) and draft fees from balances
+        asset reserved = asset(0, WAX_SYM); //requested funds reserved by proposal activation
+        asset claimed = asset(0, WAX_SYM); //deliverable funds claimed into account balances
+        asset withdrawn = asset(0, WAX_SYM); //withdrawals from account balances and draft slot refunds
+
+        uint64_t primary_key() const { return day; }
+        EOSLIB_SERIALIZE(flowday, (day)(deposited)(funded)(reserved)(claimed)(withdrawn))
+    };
+    typedef multi_index<name("flowdays"), flowday> flowdays_table;
+
     //config table
     //scope: self
     TABLE config {
@@ -302,19 +644,43 @@ CONTRACT waxlabs : public contract
         asset deposited_funds = asset(0, WAX_SYM); //total deposited funds made by accounts
         asset paid_funds = asset(0, WAX_SYM); //total lifetime funding paid
         uint32_t vote_duration = 1'209'600; //length of voting period on a proposal in seconds (default is 14 days)
-        double quorum_threshold = 10.0; //percent of votes to pass quorum
-        double yes_threshold = 50.0; //percent of yes votes to approve
+        uint16_t quorum_threshold_bps = 1'000; //basis points of supply voting to pass quorum (default is 10%)
+        uint16_t yes_threshold_bps = 5'000; //basis points of yes votes to approve (default is 50%)
         asset min_requested = asset(1000'00000000, WAX_SYM); //minimum total reqeuested amount for proposals (default is 1k WAX)
         asset max_requested = asset(500000'00000000, WAX_SYM); //maximum total reqeuested amount for proposals (default is 500k WAX)
         vector<name> categories = { name("marketing"), name("infra.tools"), name("dev.tools"), name("governance"), name("other") };
         vector<name> cat_deprecated; // list of categories unavailable for new proposals
 
-        EOSLIB_SERIALIZE(config, (contract_name)(contract_version)(admin_acct)(admin_auth)(last_proposal_id)
+        EOSLIB_SERIALIZE(config, WAXLABS_CONFIG_FIELDS)
+    };
+    typedef singleton<name("config"), config> config_singleton;
+
+    //legacy config layout with floating point thresholds, only read by migrateconf()
+    //scope: self
+    struct legacy_config {
+        string contract_name;
+        string contract_version;
+        name admin_acct;
+        name admin_auth;
+        uint64_t last_proposal_id;
+        asset available_funds;
+        asset reserved_funds;
+        asset deposited_funds;
+        asset paid_funds;
+        uint32_t vote_duration;
+        double quorum_threshold;
+        double yes_threshold;
+        asset min_requested;
+        asset max_requested;
+        vector<name> categories;
+        vector<name> cat_deprecated;
+
+        EOSLIB_SERIALIZE(legacy_config, (contract_name)(contract_version)(admin_acct)(admin_auth)(last_proposal_id)
             (available_funds)(reserved_funds)(deposited_funds)(paid_funds)
             (vote_duration)(quorum_threshold)(yes_threshold)
             (min_requested)(max_requested)(categories)(cat_deprecated))
     };
-    typedef singleton<name("config"), config> config_singleton;
+    typedef singleton<name("config"), legacy_config> legacy_config_singleton;
 
     //proposals table
     //scope: self
@@ -341,25 +707,22 @@ CONTRACT waxlabs : public contract
         uint64_t primary_key() const { return proposal_id; }
 
         // Upper 16 bits: status, category; lower 32 bits: proposal_id
-        uint64_t by_status_and_category() const { return (((uint64_t)status << 56)|((uint64_t)category << 48)|proposal_id); }
+        uint64_t by_status_and_category() const { return waxlabs_keys::status_category(status, category, proposal_id); }
 
         // Upper 16 bits: category, status; lower 32 bits: proposal_id
-        uint64_t by_category_and_status() const { return (((uint64_t)category << 56)|((uint64_t)status << 48)|proposal_id); }
+        uint64_t by_category_and_status() const { return waxlabs_keys::category_status(category, status, proposal_id); }
 
         // Upper 64 bits: proposer account; bits 63-56: status; bits 31-0: proposal_id
-        uint128_t by_proposer() const { return (((uint128_t)proposer.value << 64)|((uint128_t)status << 56)|((uint128_t)proposal_id)); }
+        uint128_t by_proposer() const { return waxlabs_keys::account_status(proposer.value, status, proposal_id); }
 
         // Upper 64 bits: reviewer account; bits 63-56: status; bits 31-0: proposal_id
-        uint128_t by_reviewer() const { return (((uint128_t)reviewer.value << 64)|((uint128_t)status << 56)|((uint128_t)proposal_id)); }
+        uint128_t by_reviewer() const { return waxlabs_keys::account_status(reviewer.value, status, proposal_id); }
 
         uint64_t by_ballot() const { return ballot_name.value; }
 
-        uint64_t by_update_ts() const { return (((uint64_t)update_ts.sec_since_epoch() << 32)|proposal_id); }
+        uint64_t by_update_ts() const { return waxlabs_keys::update_ts(update_ts.sec_since_epoch(), proposal_id); }
 
-        EOSLIB_SERIALIZE(proposal, (proposal_id)(proposer)(category)(status)(ballot_name)
-            (title)(description)(image_url)(estimated_time)(total_requested_funds)(remaining_funds)
-            (deliverables)(deliverables_completed)(reviewer)(ballot_results)
-            (update_ts)(vote_end_time)(road_map))
+        EOSLIB_SERIALIZE(proposal, WAXLABS_PROPOSAL_FIELDS)
     };
     typedef multi_index<name("proposals"), proposal,
         indexed_by<name("bystatcat"), const_mem_fun<proposal, uint64_t, &proposal::by_status_and_category>>,
@@ -378,7 +741,7 @@ CONTRACT waxlabs : public contract
 
         uint64_t primary_key() const { return proposal_id; }
 
-        EOSLIB_SERIALIZE(mdbody, (proposal_id)(content))
+        EOSLIB_SERIALIZE(mdbody, WAXLABS_MDBODY_FIELDS)
     };
     typedef multi_index<name("mdbodies"), mdbody> mdbodies_table;
 
@@ -406,8 +769,7 @@ CONTRACT waxlabs : public contract
         uint32_t days_to_complete;
 
         uint64_t primary_key() const { return deliverable_id; }
-        EOSLIB_SERIALIZE(deliverable, (deliverable_id)(status)(requested)
-            (recipient)(report)(review_time)(small_description)(days_to_complete))
+        EOSLIB_SERIALIZE(deliverable, WAXLABS_DELIVERABLE_FIELDS)
     };
     typedef multi_index<name("deliverables"), deliverable> deliverables_table;
 
@@ -423,9 +785,53 @@ CONTRACT waxlabs : public contract
     };
     typedef multi_index<name("dcomments"), dcomment> dcomments_table;
 
+    //sets a comment for a deliverable on an already opened table
+    void set_dcomment(dcomments_table& dcomments, uint64_t deliverable_id, string status_comment, name payer);
+
+    //deliverable reviewers table
+    //scope: self
+    //only deliverables with their own reviewer have a row, the others are reviewed by proposal.reviewer
+    TABLE dreviewer {
+        uint64_t proposal_id;
+        uint64_t deliverable_id;
+        name reviewer;
+
+        // Upper 32 bits: proposal_id; lower 32 bits: deliverable_id
+        uint64_t primary_key() const { return waxlabs_keys::deliverable(proposal_id, deliverable_id); }
+
+        // Upper 64 bits: reviewer account; lower 64 bits: primary key
+        uint128_t by_reviewer() const { return waxlabs_keys::account_deliverable(reviewer.value, primary_key()); }
+
+        EOSLIB_SERIALIZE(dreviewer, (proposal_id)(deliverable_id)(reviewer))
+    };
+    typedef multi_index<name("dreviewers"), dreviewer,
+        indexed_by<name("byreviewer"), const_mem_fun<dreviewer, uint128_t, &dreviewer::by_reviewer>>
+    > dreviewers_table;
+
+    //returns the account that reviews a deliverable
+    name get_dreviewer(const proposal& prop, uint64_t deliverable_id);
+
+    //erases the deliverable reviewer rows of a proposal
+    void rmv_dreviewers(uint64_t proposal_id);
+
+
+    //profile registry table
+    //scope: self
+    //fixed size row per profile, existence checks read this instead of decoding the profile details
+    //draft_slots changes in place, so a transfer notification can update it without billing RAM
+    TABLE profilereg {
+        name wax_account;
+        time_point_sec registered_ts;
+        uint32_t draft_slots = 0; //drafts prepaid with a "draft" transfer, consumed by draftprop before the account balance
+
+        uint64_t primary_key() const { return wax_account.value; }
+        EOSLIB_SERIALIZE(profilereg, (wax_account)(registered_ts)(draft_slots))
+    };
+    typedef multi_index<name("profileregs"), profilereg> profileregs_table;
 
     //profiles table
     //scope: self
+    //profile details, every string bounded by a MAX_*_LEN constant
     TABLE profile {
         name wax_account;
         string full_name;
@@ -448,10 +854,27 @@ CONTRACT waxlabs : public contract
         asset balance;
 
         uint64_t primary_key() const { return balance.symbol.code().raw(); }
-        EOSLIB_SERIALIZE(account, (balance))
+        EOSLIB_SERIALIZE(account, WAXLABS_ACCOUNT_FIELDS)
     };
     typedef multi_index<name("accounts"), account> accounts_table;
 
+    //changes table
+    //scope: self
+    //one row per mutated row per action, in commit order. indexers sync by reading rows with seq above
+    //the last one they saw; a gap between that seq and the first row means they fell out of retention.
+    TABLE change {
+        uint64_t seq; //monotonic sequence number
+        name table_name; //table of the mutated row
+        uint64_t scope; //scope of the mutated row
+        uint64_t key; //primary key of the mutated row
+        uint8_t op; //change_op
+        time_point_sec change_ts; //time of the mutating action
+
+        uint64_t primary_key() const { return seq; }
+        EOSLIB_SERIALIZE(change, WAXLABS_CHANGE_FIELDS)
+    };
+    typedef multi_index<name("changes"), change> changes_table;
+
     //wax decide treasury
     //scope: DECIDE.value
     struct treasury {
@@ -480,6 +903,142 @@ CONTRACT waxlabs : public contract
     };
     typedef multi_index<name("treasuries"), treasury> treasuries_table;
 
+    //======================== query actions ========================
+    // read-only, meant to be called through read-only transactions.
+    // results are returned through action return values.
+
+    //deliverable joined with its review comment and reviewer
+    struct deliverable_view {
+        deliverable deliv;
+        string status_comment;
+        name reviewer; //deliverable reviewer, or proposal.reviewer if none is assigned
+
+        EOSLIB_SERIALIZE(deliverable_view, (deliv)(status_comment)(reviewer))
+    };
+
+    //proposal joined with its body, comments, deliverables and proposer profile
+    struct proposal_view {
+        proposal prop;
+        string mdbody;
+        string status_comment;
+        vector<deliverable_view> deliverables;
+        optional<profile> proposer_profile;
+
+        EOSLIB_SERIALIZE(proposal_view, (prop)(mdbody)(status_comment)(deliverables)(proposer_profile))
+    };
+
+    //one page of proposal views. pass next_key as lower_bound to fetch the following page.
+    struct proposal_page {
+        vector<proposal_view> proposals;
+        bool more = false;
+        uint128_t next_key = 0;
+
+        EOSLIB_SERIALIZE(proposal_page, (proposals)(more)(next_key))
+    };
+
+    //read-only actions need Antelope CDT 3.0+ and are called with send_read_only_transaction on Leap 4.0+
+
+    //get a single proposal with everything needed to render its page
+    [[eosio::action, eosio::read_only]] proposal_view getproposal(uint64_t proposal_id);
+
+    //walk a proposals index from lower_bound to upper_bound (inclusive)
+    //pre: index_name is bystatcat, bycatstat, byproposer or byupdatets. limit <= MAX_PAGE_SIZE
+    //     bounds fit the index key, bystatcat, bycatstat and byupdatets are 64-bit
+    [[eosio::action, eosio::read_only]] proposal_page getprops(name index_name, uint128_t lower_bound,
+        uint128_t upper_bound, uint32_t limit);
+
+    //joins a proposal with its body, comments, deliverables and proposer profile
+    proposal_view make_proposal_view(const proposal& prop);
+
+    //collects up to limit views from a proposals secondary index
+    template<typename Index>
+    proposal_page walk_proposals(const Index& index, uint128_t lower_bound, uint128_t upper_bound, uint32_t limit);
+
+    //approves or rejects a submitted proposal, shared by reviewprop() and reviewprops()
+    proposal_result review_proposal(proposals_table& proposals, const proposal& prop, bool approve, const string& memo);
+
+    //moves a submitted proposal to inprogress and reserves its funds, shared by skipvoting() and reviewprops()
+    //funding must be checked by the caller
+    proposal_result skip_voting(proposals_table& proposals, const proposal& prop);
+
+    //builds the result returned by proposal actions
+    static proposal_result make_proposal_result(const proposal& prop);
+
+    //builds the result returned by deliverable actions
+    static deliverable_result make_deliverable_result(const proposal& prop, const deliverable& deliv);
+
+    //======================== unit of work ========================
+    // config, stats, fundstats, fundscans and flowdays rows are loaded once per action, changed in memory
+    // and written exactly once by flush() when the contract object is destroyed.
+
+    //returns the cached config, loading it on first use
+    config& get_config();
+
+    //marks the cached config to be written on flush
+    void save_config();
+
+    //writes every dirty config, stats, fundstats, fundscans and flowdays row once, then appends the pending changes
+    void flush();
+
+    //returns the cached flowdays row of today, written on flush
+    flowday& flow_today();
+
+    //records a row mutation, written to the changes table on flush
+    void log_change(name table_name, uint64_t scope, uint64_t key, change_op op);
+
+    //prints a shared row access ("R" or "W") to the action console, only in the trace build: ./build.sh waxlabs trace
+    //used by conflicts.sh to find rows that serialize otherwise independent transactions
+    void trace_row(const char* access, name table_name, uint64_t scope, uint64_t key) {
+#ifdef WAXLABS_TRACE_ROWS
+        print(access, " ", table_name, " ", scope, " ", key, "\n");
+#endif
+    }
+
+    private:
+
+    //cached stats row, stored == row exists on chain, exists == row exists after flush
+    struct stat_entry {
+        stat row;
+        bool exists = false;
+        bool stored = false;
+        bool dirty = false;
+    };
+
+    //returns the cached stats row for key, loading it on first use
+    stat_entry& load_stat(uint64_t key);
+
+    //cached fundstats row and recompfunds scan of one bucket, stored == row exists on chain,
+    //scanning == scan row exists after flush
+    struct fundstat_entry {
+        fundstat row;
+        bool stored = false;
+        bool dirty = false;
+        fundscan scan;
+        bool scanning = false;
+        bool scan_stored = false;
+        bool scan_dirty = false;
+    };
+
+    //returns the cached fundstats row and scan of a category and status, loading them on first use
+    fundstat_entry& load_fundstat(uint8_t category, uint8_t status);
+
+    config_singleton _configs;
+    config _conf;
+    bool _conf_loaded = false;
+    bool _conf_dirty = false;
+
+    stats _stats;
+    map<uint64_t, stat_entry> _stat_cache;
+
+    fundstats_table _fundstats;
+    fundscans_table _fundscans;
+    map<uint64_t, fundstat_entry> _fundstat_cache;
+
+    flowday _flow;
+    bool _flow_loaded = false;
+
+    vector<change> _pending_changes;
+
 };
 
 
@@ -0,0 +1,245 @@
+// Native action builders for WAX Labs transactions.
+//
+// Off-chain only: plain C++17 plus Boost.Preprocessor, no eosio.cdt. Each
+// action has a typed argument struct generated from the parameter list in
+// waxlabs_fields.hpp that also declares the action in waxlabs.hpp. It is
+// packed straight to the binary action data, so clients skip the
+// abi_json_to_bin round trip. Several actions can be packed into one
+// transaction. Signing and pushing are left to the caller: sign the digest of
+// signing_data() with keosd or a secp256k1 library, then send hex(packed) as
+// the packed_trx of /v1/chain/send_transaction. waxlabs_push.hpp does both
+// with keosd and Boost.Beast.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+
+#include "waxlabs_codec.hpp"
+#include "waxlabs_fields.hpp"
+
+namespace waxlabs_client {
+
+    using waxlabs_codec::asset;
+    using waxlabs_codec::name;
+
+    //raw symbol value of the WAX token, 8 decimals
+    constexpr uint64_t WAX_SYMBOL = 8 | uint64_t('W') << 8 | uint64_t('A') << 16 | uint64_t('X') << 24;
+
+    inline asset wax(int64_t amount) {
+        return asset{amount, WAX_SYMBOL};
+    }
+
+    //appending cursor, packs values in the chain encoding
+    struct writer {
+        std::string& out;
+
+        void varuint32(uint32_t value) {
+            do {
+                uint8_t byte = value & 0x7f;
+                value >>= 7;
+                out.push_back(char(value ? byte | 0x80 : byte));
+            } while (value);
+        }
+    };
+
+    //integers and assets are fixed size little endian
+    template<typename T>
+    inline void write(writer& wr, const T& value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_same_v<T, asset>, "no packed encoding for this type");
+        wr.out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void write(writer& wr, const name& value) {
+        write(wr, value.value);
+    }
+
+    inline void write(writer& wr, bool value) {
+        wr.out.push_back(char(value ? 1 : 0));
+    }
+
+    inline void write(writer& wr, std::string_view value) {
+        wr.varuint32(uint32_t(value.size()));
+        wr.out.append(value.data(), value.size());
+    }
+
+    inline void write(writer& wr, const std::string& value) {
+        write(wr, std::string_view(value));
+    }
+
+    template<typename T>
+    inline void write(writer& wr, const std::optional<T>& value) {
+        write(wr, value.has_value());
+        if (value) write(wr, *value);
+    }
+
+    template<typename T>
+    inline void write(writer& wr, const std::vector<T>& value) {
+        wr.varuint32(uint32_t(value.size()));
+        for (auto& item : value) write(wr, item);
+    }
+
+    //======================== action arguments ========================
+
+    //spellings of the parameter types in waxlabs_fields.hpp
+    using std::string;
+    using std::optional;
+    using std::vector;
+
+    //eosio.token transfer, deposits to the contract (memo "", "fund" or "draft")
+    #define WAXLABS_CLIENT_TRANSFER_PARAMS ((name, from))((name, to))((asset, quantity))((string, memo))
+
+    #define WAXLABS_CLIENT_WRITE_PARAM(r, ARGS, PARAM) write(wr, ARGS.BOOST_PP_TUPLE_ELEM(2, 1, PARAM));
+
+    //argument struct with the parameters of PARAMS as members, packed in their order
+    #define WAXLABS_CLIENT_STRUCT(TYPE, PARAMS) \
+        struct TYPE { WAXLABS_MEMBERS(PARAMS) }; \
+        inline void write(writer& wr, const TYPE& args) { \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_CLIENT_WRITE_PARAM, args, PARAMS) \
+        }
+
+    #define WAXLABS_CLIENT_ACTION(TYPE, PARAMS) \
+        WAXLABS_CLIENT_STRUCT(TYPE, PARAMS) \
+        constexpr name action_name(const TYPE&) { return name(#TYPE); }
+
+    WAXLABS_CLIENT_ACTION(draftprop, WAXLABS_DRAFTPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(editprop, WAXLABS_EDITPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(submitprop, WAXLABS_SUBMITPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(reviewprop, WAXLABS_REVIEWPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(skipvoting, WAXLABS_SKIPVOTING_PARAMS)
+    WAXLABS_CLIENT_STRUCT(proposal_review, WAXLABS_PROPOSAL_REVIEW_PARAMS)
+    WAXLABS_CLIENT_ACTION(reviewprops, WAXLABS_REVIEWPROPS_PARAMS)
+    WAXLABS_CLIENT_ACTION(beginvoting, WAXLABS_BEGINVOTING_PARAMS)
+    WAXLABS_CLIENT_ACTION(endvoting, WAXLABS_ENDVOTING_PARAMS)
+    WAXLABS_CLIENT_ACTION(setreviewer, WAXLABS_SETREVIEWER_PARAMS)
+    WAXLABS_CLIENT_ACTION(cancelprop, WAXLABS_CANCELPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(deleteprop, WAXLABS_DELETEPROP_PARAMS)
+    WAXLABS_CLIENT_ACTION(newdeliv, WAXLABS_NEWDELIV_PARAMS)
+    WAXLABS_CLIENT_ACTION(rmvdeliv, WAXLABS_RMVDELIV_PARAMS)
+    WAXLABS_CLIENT_ACTION(editdeliv, WAXLABS_EDITDELIV_PARAMS)
+    WAXLABS_CLIENT_ACTION(submitreport, WAXLABS_SUBMITREPORT_PARAMS)
+    WAXLABS_CLIENT_ACTION(reviewdeliv, WAXLABS_REVIEWDELIV_PARAMS)
+    WAXLABS_CLIENT_ACTION(claimfunds, WAXLABS_CLAIMFUNDS_PARAMS)
+    WAXLABS_CLIENT_ACTION(setdreviewer, WAXLABS_SETDREVIEWER_PARAMS)
+    WAXLABS_CLIENT_ACTION(newprofile, WAXLABS_PROFILE_PARAMS)
+    WAXLABS_CLIENT_ACTION(editprofile, WAXLABS_PROFILE_PARAMS)
+    WAXLABS_CLIENT_ACTION(rmvprofile, WAXLABS_RMVPROFILE_PARAMS)
+    WAXLABS_CLIENT_ACTION(withdraw, WAXLABS_WITHDRAW_PARAMS)
+    WAXLABS_CLIENT_ACTION(refundslots, WAXLABS_REFUNDSLOTS_PARAMS)
+    WAXLABS_CLIENT_ACTION(transfer, WAXLABS_CLIENT_TRANSFER_PARAMS)
+
+    #undef WAXLABS_CLIENT_ACTION
+    #undef WAXLABS_CLIENT_STRUCT
+    #undef WAXLABS_CLIENT_WRITE_PARAM
+    #undef WAXLABS_CLIENT_TRANSFER_PARAMS
+
+    //======================== transactions ========================
+
+    struct permission_level {
+        name actor;
+        name permission;
+    };
+
+    struct action {
+        name account;
+        name action_name;
+        std::vector<permission_level> authorization;
+        std::string data; //packed arguments
+    };
+
+    struct transaction_header {
+        uint32_t expiration; //seconds since epoch
+        uint16_t ref_block_num; //low 16 bits of the reference block number
+        uint32_t ref_block_prefix; //bytes 8 to 11 of the reference block id
+        uint32_t max_net_usage_words = 0;
+        uint8_t max_cpu_usage_ms = 0;
+        uint32_t delay_sec = 0;
+    };
+
+    //builds an action of contract from typed arguments, authorized by actor@active
+    template<typename Args>
+    inline action make_action(name contract, name actor, const Args& args) {
+        action act{contract, action_name(args), {{actor, name("active")}}, {}};
+        writer wr{act.data};
+        write(wr, args);
+        return act;
+    }
+
+    inline void write(writer& wr, const permission_level& value) {
+        write(wr, value.actor);
+        write(wr, value.permission);
+    }
+
+    inline void write(writer& wr, const action& value) {
+        write(wr, value.account);
+        write(wr, value.action_name);
+        write(wr, value.authorization);
+        write(wr, value.data);
+    }
+
+    //packs a transaction running actions in order, all or nothing
+    inline std::string pack_transaction(const transaction_header& header, const action* actions, size_t count) {
+        std::string out;
+        writer wr{out};
+        write(wr, header.expiration);
+        write(wr, header.ref_block_num);
+        write(wr, header.ref_block_prefix);
+        wr.varuint32(header.max_net_usage_words);
+        write(wr, header.max_cpu_usage_ms);
+        wr.varuint32(header.delay_sec);
+        wr.varuint32(0); //context free actions
+        wr.varuint32(uint32_t(count));
+        for (size_t i = 0; i < count; i++) write(wr, actions[i]);
+        wr.varuint32(0); //transaction extensions
+        return out;
+    }
+
+    inline std::string pack_transaction(const transaction_header& header, const std::vector<action>& actions) {
+        return pack_transaction(header, actions.data(), actions.size());
+    }
+
+    //packs actions into transactions of at most max_actions each. every transaction
+    //must still fit the block CPU limit, and a failing action reverts its whole transaction.
+    inline std::vector<std::string> pack_batches(const transaction_header& header, const std::vector<action>& actions,
+        size_t max_actions) {
+        if (max_actions == 0) {
+            throw std::invalid_argument("max_actions must be greater than zero");
+        }
+        std::vector<std::string> batches;
+        for (size_t i = 0; i < actions.size(); i += max_actions) {
+            batches.push_back(pack_transaction(header, actions.data() + i, std::min(max_actions, actions.size() - i)));
+        }
+        return batches;
+    }
+
+    //bytes whose sha256 is signed: chain id, packed transaction, empty context free data hash
+    inline std::string signing_data(std::string_view chain_id, std::string_view packed) {
+        std::string out(chain_id);
+        out.append(packed.data(), packed.size());
+        out.append(32, '\0');
+        return out;
+    }
+
+    //lowercase hex, as expected by packed_trx and chain_id fields
+    inline std::string hex(std::string_view data) {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::string out;
+        out.reserve(data.size() * 2);
+        for (unsigned char c : data) {
+            out.push_back(digits[c >> 4]);
+            out.push_back(digits[c & 0x0f]);
+        }
+        return out;
+    }
+
+}
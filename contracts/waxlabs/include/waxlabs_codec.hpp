@@ -0,0 +1,270 @@
+// Native decoders for WAX Labs table rows.
+//
+// Off-chain only: plain C++17 plus Boost.Preprocessor, no eosio.cdt. Rows are
+// decoded straight from the packed table bytes in the field order of
+// waxlabs_fields.hpp. Strings, lists and maps are views into the source
+// buffer, so decoding a row never allocates; the buffer must outlive the row.
+// encode() packs a decoded row back into the same bytes.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <boost/preprocessor/seq/for_each.hpp>
+
+#include "waxlabs_fields.hpp"
+
+namespace waxlabs_codec {
+
+    struct name {
+        uint64_t value = 0;
+
+        constexpr name() = default;
+        constexpr explicit name(uint64_t raw) : value(raw) {}
+
+        //same encoding as eosio::name, invalid characters map to 0
+        constexpr explicit name(std::string_view str) {
+            for (size_t i = 0; i < str.size() && i < 13; i++) {
+                uint64_t c = char_value(str[i]);
+                value |= i < 12 ? (c & 0x1f) << (64 - 5 * (i + 1)) : c & 0x0f;
+            }
+        }
+
+        //same text as eosio::name::to_string, trailing dots trimmed
+        std::string to_string() const {
+            static constexpr char charmap[] = ".12345abcdefghijklmnopqrstuvwxyz";
+            std::string str(13, '.');
+            uint64_t tmp = value;
+            for (int i = 12; i >= 0; i--) {
+                str[i] = charmap[tmp & (i == 12 ? 0x0f : 0x1f)];
+                tmp >>= (i == 12 ? 4 : 5);
+            }
+            str.erase(str.find_last_not_of('.') + 1);
+            return str;
+        }
+
+        static constexpr uint64_t char_value(char c) {
+            if (c >= 'a' && c <= 'z') return uint64_t(c - 'a') + 6;
+            if (c >= '1' && c <= '5') return uint64_t(c - '1') + 1;
+            return 0;
+        }
+    };
+
+    struct asset {
+        int64_t amount;
+        uint64_t symbol;
+    };
+
+    //packed list of fixed size elements, read lazily from the source buffer
+    template<typename T>
+    struct list_view {
+        uint32_t size = 0;
+        const char* data = nullptr;
+
+        T operator[](uint32_t i) const {
+            T value;
+            std::memcpy(&value, data + i * sizeof(T), sizeof(T));
+            return value;
+        }
+    };
+
+    //map<name, asset> entry
+    struct name_asset {
+        uint64_t key;
+        asset value;
+    };
+
+    struct config {
+        std::string_view contract_name;
+        std::string_view contract_version;
+        uint64_t admin_acct;
+        uint64_t admin_auth;
+        uint64_t last_proposal_id;
+        asset available_funds;
+        asset reserved_funds;
+        asset deposited_funds;
+        asset paid_funds;
+        uint32_t vote_duration;
+        uint16_t quorum_threshold_bps;
+        uint16_t yes_threshold_bps;
+        asset min_requested;
+        asset max_requested;
+        list_view<uint64_t> categories;
+        list_view<uint64_t> cat_deprecated;
+    };
+
+    struct proposal {
+        uint64_t proposal_id;
+        uint64_t proposer;
+        uint8_t category;
+        uint8_t status;
+        uint64_t ballot_name;
+        std::string_view title;
+        std::string_view description;
+        std::string_view image_url;
+        uint32_t estimated_time;
+        asset total_requested_funds;
+        asset remaining_funds;
+        uint8_t deliverables;
+        uint8_t deliverables_completed;
+        uint64_t reviewer;
+        list_view<name_asset> ballot_results;
+        uint32_t update_ts;
+        uint32_t vote_end_time;
+        std::string_view road_map;
+    };
+
+    struct mdbody {
+        uint64_t proposal_id;
+        std::string_view content;
+    };
+
+    struct deliverable {
+        uint64_t deliverable_id;
+        uint8_t status;
+        asset requested;
+        uint64_t recipient;
+        std::string_view report;
+        uint32_t review_time;
+        std::string_view small_description;
+        uint32_t days_to_complete;
+    };
+
+    struct stat {
+        uint64_t key;
+        std::string_view val_name;
+        unsigned __int128 current_count;
+        unsigned __int128 total_count;
+    };
+
+    struct account {
+        asset balance;
+    };
+
+    struct change {
+        uint64_t seq;
+        uint64_t table_name;
+        uint64_t scope;
+        uint64_t key;
+        uint8_t op;
+        uint32_t change_ts;
+    };
+
+    //bounds checked cursor over a packed row, ok turns false on the first overrun
+    struct reader {
+        const char* pos;
+        const char* end;
+        bool ok = true;
+
+        bool take(size_t size) {
+            ok = ok && size <= size_t(end - pos);
+            return ok;
+        }
+
+        uint32_t varuint32() {
+            uint32_t value = 0;
+            for (int shift = 0; shift < 35 && take(1); shift += 7) {
+                uint8_t byte = uint8_t(*pos++);
+                value |= uint32_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80)) return value;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+
+    //integers, names, time_point_sec and assets are fixed size little endian
+    template<typename T>
+    inline void read(reader& rd, T& value) {
+        if (rd.take(sizeof(T))) {
+            std::memcpy(&value, rd.pos, sizeof(T));
+            rd.pos += sizeof(T);
+        }
+    }
+
+    inline void read(reader& rd, std::string_view& value) {
+        uint32_t size = rd.varuint32();
+        if (rd.take(size)) {
+            value = std::string_view(rd.pos, size);
+            rd.pos += size;
+        }
+    }
+
+    template<typename T>
+    inline void read(reader& rd, list_view<T>& value) {
+        value.size = rd.varuint32();
+        value.data = rd.pos;
+        if (rd.take(size_t(value.size) * sizeof(T))) {
+            rd.pos += size_t(value.size) * sizeof(T);
+        }
+    }
+
+    static_assert(sizeof(asset) == 16 && sizeof(name_asset) == 24, "packed layout must match the chain encoding");
+
+    #define WAXLABS_CODEC_READ_FIELD(r, ROW, FIELD) read(rd, ROW.FIELD);
+
+    #define WAXLABS_CODEC_DECODER(TYPE, FIELDS) \
+        inline bool decode(const char* data, size_t size, TYPE& row) { \
+            reader rd{data, data + size}; \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_CODEC_READ_FIELD, row, FIELDS) \
+            return rd.ok && rd.pos == rd.end; \
+        }
+
+    WAXLABS_CODEC_DECODER(config, WAXLABS_CONFIG_FIELDS)
+    WAXLABS_CODEC_DECODER(proposal, WAXLABS_PROPOSAL_FIELDS)
+    WAXLABS_CODEC_DECODER(mdbody, WAXLABS_MDBODY_FIELDS)
+    WAXLABS_CODEC_DECODER(deliverable, WAXLABS_DELIVERABLE_FIELDS)
+    WAXLABS_CODEC_DECODER(stat, WAXLABS_STAT_FIELDS)
+    WAXLABS_CODEC_DECODER(account, WAXLABS_ACCOUNT_FIELDS)
+    WAXLABS_CODEC_DECODER(change, WAXLABS_CHANGE_FIELDS)
+
+    #undef WAXLABS_CODEC_DECODER
+    #undef WAXLABS_CODEC_READ_FIELD
+
+    inline void write_varuint32(std::string& out, uint32_t value) {
+        do {
+            uint8_t byte = value & 0x7f;
+            value >>= 7;
+            out += char(value ? byte | 0x80 : byte);
+        } while (value);
+    }
+
+    template<typename T>
+    inline void write(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    inline void write(std::string& out, std::string_view value) {
+        write_varuint32(out, uint32_t(value.size()));
+        out.append(value.data(), value.size());
+    }
+
+    template<typename T>
+    inline void write(std::string& out, const list_view<T>& value) {
+        write_varuint32(out, value.size);
+        out.append(value.data, size_t(value.size) * sizeof(T));
+    }
+
+    #define WAXLABS_CODEC_WRITE_FIELD(r, ROW, FIELD) write(out, ROW.FIELD);
+
+    //appends the packed row to out
+    #define WAXLABS_CODEC_ENCODER(TYPE, FIELDS) \
+        inline void encode(const TYPE& row, std::string& out) { \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_CODEC_WRITE_FIELD, row, FIELDS) \
+        }
+
+    WAXLABS_CODEC_ENCODER(config, WAXLABS_CONFIG_FIELDS)
+    WAXLABS_CODEC_ENCODER(proposal, WAXLABS_PROPOSAL_FIELDS)
+    WAXLABS_CODEC_ENCODER(mdbody, WAXLABS_MDBODY_FIELDS)
+    WAXLABS_CODEC_ENCODER(deliverable, WAXLABS_DELIVERABLE_FIELDS)
+    WAXLABS_CODEC_ENCODER(stat, WAXLABS_STAT_FIELDS)
+    WAXLABS_CODEC_ENCODER(account, WAXLABS_ACCOUNT_FIELDS)
+    WAXLABS_CODEC_ENCODER(change, WAXLABS_CHANGE_FIELDS)
+
+    #undef WAXLABS_CODEC_ENCODER
+    #undef WAXLABS_CODEC_WRITE_FIELD
+
+}
@@ -0,0 +1,452 @@
+// Columnar files of WAX Labs table rows.
+//
+// Off-chain only: C++17 plus Boost.Preprocessor, no eosio.cdt. A file holds
+// one table with every column stored contiguously, so an analyst reads one
+// field of every row without touching the others. Tables with a
+// waxlabs_codec decoder get one column per field of waxlabs_fields.hpp, with
+// assets split into <field>.amount and <field>.symbol. Other tables keep
+// their packed rows in a data column. Every table starts with scope and
+// primary_key columns.
+//
+// File layout, little endian:
+//
+//   "WLCOLS01"  magic
+//   uint64      contract
+//   uint32      last block of the source store
+//   uint64      table name
+//   uint64      rows
+//   uint32      columns
+//   columns     uint8 type, uint32 name size, name, uint64 data size, data
+//
+// A fixed width column holds one value per row. A bytes column holds rows + 1
+// uint64 offsets, then the values back to back. table_file loads a file
+// with one read, and for_each_row() packs its rows back into the contract
+// layout to seed a store.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/stringize.hpp>
+
+#include "waxlabs_codec.hpp"
+
+namespace waxlabs_columns {
+
+    constexpr char MAGIC[8] = {'W', 'L', 'C', 'O', 'L', 'S', '0', '1'};
+
+    enum class column_type : uint8_t {
+        uint8 = 1,
+        uint16 = 2,
+        uint32 = 3,
+        uint64 = 4,
+        int64 = 5,
+        bytes = 6
+    };
+
+    inline size_t column_width(column_type type) {
+        switch (type) {
+            case column_type::uint8: return 1;
+            case column_type::uint16: return 2;
+            case column_type::uint32: return 4;
+            case column_type::uint64: return 8;
+            case column_type::int64: return 8;
+            default: return 0;
+        }
+    }
+
+    template<typename T> constexpr column_type type_of();
+    template<> constexpr column_type type_of<uint8_t>() { return column_type::uint8; }
+    template<> constexpr column_type type_of<uint16_t>() { return column_type::uint16; }
+    template<> constexpr column_type type_of<uint32_t>() { return column_type::uint32; }
+    template<> constexpr column_type type_of<uint64_t>() { return column_type::uint64; }
+    template<> constexpr column_type type_of<int64_t>() { return column_type::int64; }
+
+    //tables with a codec decoder
+    constexpr uint64_t CONFIG = waxlabs_codec::name("config").value;
+    constexpr uint64_t PROPOSALS = waxlabs_codec::name("proposals").value;
+    constexpr uint64_t MDBODIES = waxlabs_codec::name("mdbodies").value;
+    constexpr uint64_t DELIVERABLES = waxlabs_codec::name("deliverables").value;
+    constexpr uint64_t ACCOUNTS = waxlabs_codec::name("accounts").value;
+    constexpr uint64_t CHANGES = waxlabs_codec::name("changes").value;
+
+    //======================== writing ========================
+
+    struct column {
+        std::string name;
+        column_type type;
+        std::string data; //fixed width values, or bytes values back to back
+        std::vector<uint64_t> ends; //bytes columns, end offset of each value in data
+    };
+
+    //columns of a run of rows, built one row at a time in field order
+    class column_set {
+        public:
+
+        void begin_row() {
+            _pos = 0;
+            _rows++;
+        }
+
+        template<typename T>
+        void add(const char* name, T value) {
+            next(name, "", type_of<T>()).data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void add(const char* name, const waxlabs_codec::asset& value) {
+            add_fixed(next(name, ".amount", column_type::int64), value.amount);
+            add_fixed(next(name, ".symbol", column_type::uint64), value.symbol);
+        }
+
+        void add(const char* name, std::string_view value) {
+            column& col = next(name, "", column_type::bytes);
+            col.data.append(value.data(), value.size());
+            col.ends.push_back(col.data.size());
+        }
+
+        //lists keep their packed elements, the count is the size over the element size
+        template<typename T>
+        void add(const char* name, const waxlabs_codec::list_view<T>& value) {
+            add(name, std::string_view(value.data, size_t(value.size) * sizeof(T)));
+        }
+
+        size_t rows() const { return _rows; }
+        const std::vector<column>& columns() const { return _columns; }
+
+        private:
+
+        template<typename T>
+        static void add_fixed(column& col, T value) {
+            col.data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        //the column at the current field position, created by the first row
+        column& next(const char* name, const char* suffix, column_type type) {
+            if (_pos == _columns.size()) {
+                _columns.push_back(column{std::string(name) + suffix, type, {}, {}});
+            }
+            column& col = _columns[_pos++];
+            if (col.type != type) {
+                throw std::logic_error("column " + col.name + " changed type");
+            }
+            return col;
+        }
+
+        std::vector<column> _columns;
+        size_t _pos = 0;
+        size_t _rows = 0;
+    };
+
+    #define WAXLABS_COLUMNS_ADD_FIELD(r, ROW, FIELD) cols.add(BOOST_PP_STRINGIZE(FIELD), ROW.FIELD);
+
+    #define WAXLABS_COLUMNS_ADD_ROW(TYPE, FIELDS) \
+        inline void add_fields(column_set& cols, const waxlabs_codec::TYPE& row) { \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_COLUMNS_ADD_FIELD, row, FIELDS) \
+        }
+
+    WAXLABS_COLUMNS_ADD_ROW(config, WAXLABS_CONFIG_FIELDS)
+    WAXLABS_COLUMNS_ADD_ROW(proposal, WAXLABS_PROPOSAL_FIELDS)
+    WAXLABS_COLUMNS_ADD_ROW(mdbody, WAXLABS_MDBODY_FIELDS)
+    WAXLABS_COLUMNS_ADD_ROW(deliverable, WAXLABS_DELIVERABLE_FIELDS)
+    WAXLABS_COLUMNS_ADD_ROW(account, WAXLABS_ACCOUNT_FIELDS)
+    WAXLABS_COLUMNS_ADD_ROW(change, WAXLABS_CHANGE_FIELDS)
+
+    #undef WAXLABS_COLUMNS_ADD_ROW
+    #undef WAXLABS_COLUMNS_ADD_FIELD
+
+    template<typename Row>
+    inline void add_decoded(column_set& cols, uint64_t table, const char* data, size_t size) {
+        Row row;
+        if (!waxlabs_codec::decode(data, size, row)) {
+            throw std::runtime_error(waxlabs_codec::name(table).to_string() + " row does not match the codec layout");
+        }
+        add_fields(cols, row);
+    }
+
+    //appends one packed row of table, decoded into fields when the codec knows the table
+    inline void add_row(column_set& cols, uint64_t table, uint64_t scope, uint64_t primary_key, const char* data, size_t size) {
+        cols.begin_row();
+        cols.add("scope", scope);
+        cols.add("primary_key", primary_key);
+        switch (table) {
+            case CONFIG: add_decoded<waxlabs_codec::config>(cols, table, data, size); break;
+            case PROPOSALS: add_decoded<waxlabs_codec::proposal>(cols, table, data, size); break;
+            case MDBODIES: add_decoded<waxlabs_codec::mdbody>(cols, table, data, size); break;
+            case DELIVERABLES: add_decoded<waxlabs_codec::deliverable>(cols, table, data, size); break;
+            case ACCOUNTS: add_decoded<waxlabs_codec::account>(cols, table, data, size); break;
+            case CHANGES: add_decoded<waxlabs_codec::change>(cols, table, data, size); break;
+            default: cols.add("data", std::string_view(data, size));
+        }
+    }
+
+    //writes the rows of chunks, in order, as one table file. returns the file size
+    inline uint64_t write_table(const std::string& path, uint64_t contract, uint32_t last_block, uint64_t table,
+        const std::vector<column_set>& chunks) {
+        std::vector<const column_set*> filled;
+        uint64_t rows = 0;
+        for (const auto& chunk : chunks) {
+            if (chunk.rows() == 0) continue;
+            if (!filled.empty() && chunk.columns().size() != filled.front()->columns().size()) {
+                throw std::logic_error("chunks of " + waxlabs_codec::name(table).to_string() + " have different columns");
+            }
+            filled.push_back(&chunk);
+            rows += chunk.rows();
+        }
+        uint32_t column_count = filled.empty() ? 0 : uint32_t(filled.front()->columns().size());
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("cannot write " + path);
+        }
+        auto put = [&](const void* value, size_t size) { out.write(static_cast<const char*>(value), size); };
+        put(MAGIC, sizeof(MAGIC));
+        put(&contract, 8);
+        put(&last_block, 4);
+        put(&table, 8);
+        put(&rows, 8);
+        put(&column_count, 4);
+
+        for (uint32_t c = 0; c < column_count; c++) {
+            const column& first = filled.front()->columns()[c];
+            uint64_t size = 0;
+            for (auto chunk : filled) size += chunk->columns()[c].data.size();
+            if (first.type == column_type::bytes) size += (rows + 1) * 8;
+
+            uint8_t type = uint8_t(first.type);
+            uint32_t name_size = uint32_t(first.name.size());
+            put(&type, 1);
+            put(&name_size, 4);
+            put(first.name.data(), name_size);
+            put(&size, 8);
+
+            if (first.type == column_type::bytes) {
+                uint64_t base = 0;
+                put(&base, 8);
+                for (auto chunk : filled) {
+                    for (uint64_t end : chunk->columns()[c].ends) {
+                        uint64_t offset = base + end;
+                        put(&offset, 8);
+                    }
+                    base += chunk->columns()[c].data.size();
+                }
+            }
+            for (auto chunk : filled) {
+                put(chunk->columns()[c].data.data(), chunk->columns()[c].data.size());
+            }
+        }
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("cannot write " + path);
+        }
+        return uint64_t(out.tellp());
+    }
+
+    //======================== loading ========================
+
+    struct column_view {
+        std::string_view name;
+        column_type type;
+        const char* data; //fixed width values, or the bytes values after the offsets
+        const uint64_t* offsets; //bytes columns only, rows + 1 entries, unaligned
+    };
+
+    //one table file, read into memory and checked once
+    class table_file {
+        public:
+
+        explicit table_file(const std::string& path) {
+            std::ifstream in(path, std::ios::binary | std::ios::ate);
+            if (!in) {
+                throw std::runtime_error("cannot open " + path);
+            }
+            _buffer.resize(size_t(in.tellg()));
+            in.seekg(0);
+            if (!in.read(_buffer.data(), _buffer.size())) {
+                throw std::runtime_error("cannot read " + path);
+            }
+
+            const char* pos = _buffer.data();
+            const char* end = pos + _buffer.size();
+            auto take = [&](void* value, size_t size) {
+                if (size > size_t(end - pos)) throw std::runtime_error(path + " is truncated");
+                std::memcpy(value, pos, size);
+                pos += size;
+            };
+            char magic[sizeof(MAGIC)];
+            take(magic, sizeof(magic));
+            if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+                throw std::runtime_error(path + " is not a waxlabs column file");
+            }
+            uint32_t column_count = 0;
+            take(&_contract, 8);
+            take(&_last_block, 4);
+            take(&_table, 8);
+            take(&_rows, 8);
+            take(&column_count, 4);
+
+            for (uint32_t c = 0; c < column_count; c++) {
+                uint8_t type = 0;
+                uint32_t name_size = 0;
+                uint64_t size = 0;
+                take(&type, 1);
+                take(&name_size, 4);
+                if (name_size > size_t(end - pos)) throw std::runtime_error(path + " is truncated");
+                std::string_view col_name(pos, name_size);
+                pos += name_size;
+                take(&size, 8);
+                if (size > uint64_t(end - pos)) throw std::runtime_error(path + " is truncated");
+
+                column_view col{col_name, column_type(type), pos, nullptr};
+                if (col.type == column_type::bytes) {
+                    uint64_t index_size = (_rows + 1) * 8;
+                    col.offsets = reinterpret_cast<const uint64_t*>(pos);
+                    col.data = pos + index_size;
+                    if (size < index_size || offset(col, 0) != 0 || offset(col, _rows) != size - index_size) {
+                        throw std::runtime_error(path + ": bad offsets in column " + std::string(col_name));
+                    }
+                    for (uint64_t i = 0; i < _rows; i++) {
+                        if (offset(col, i) > offset(col, i + 1)) {
+                            throw std::runtime_error(path + ": bad offsets in column " + std::string(col_name));
+                        }
+                    }
+                } else if (column_width(col.type) == 0 || size != _rows * column_width(col.type)) {
+                    throw std::runtime_error(path + ": bad size of column " + std::string(col_name));
+                }
+                _columns.push_back(col);
+                pos += size;
+            }
+        }
+
+        uint64_t contract() const { return _contract; }
+        uint32_t last_block() const { return _last_block; }
+        uint64_t table() const { return _table; }
+        uint64_t rows() const { return _rows; }
+        const std::vector<column_view>& columns() const { return _columns; }
+
+        const column_view* find(std::string_view col_name) const {
+            for (const auto& col : _columns) {
+                if (col.name == col_name) return &col;
+            }
+            return nullptr;
+        }
+
+        template<typename T>
+        T value(const column_view& col, uint64_t row) const {
+            T result;
+            std::memcpy(&result, col.data + row * sizeof(T), sizeof(T));
+            return result;
+        }
+
+        std::string_view bytes(const column_view& col, uint64_t row) const {
+            uint64_t begin = offset(col, row);
+            return std::string_view(col.data + begin, offset(col, row + 1) - begin);
+        }
+
+        //reads the field at column position pos of row and moves pos past it
+        template<typename T>
+        void get(size_t& pos, uint64_t row, T& field) const {
+            field = value<T>(column_at(pos++, type_of<T>()), row);
+        }
+
+        void get(size_t& pos, uint64_t row, waxlabs_codec::asset& field) const {
+            field.amount = value<int64_t>(column_at(pos++, column_type::int64), row);
+            field.symbol = value<uint64_t>(column_at(pos++, column_type::uint64), row);
+        }
+
+        void get(size_t& pos, uint64_t row, std::string_view& field) const {
+            field = bytes(column_at(pos++, column_type::bytes), row);
+        }
+
+        template<typename T>
+        void get(size_t& pos, uint64_t row, waxlabs_codec::list_view<T>& field) const {
+            std::string_view packed = bytes(column_at(pos++, column_type::bytes), row);
+            if (packed.size() % sizeof(T) != 0) {
+                throw std::runtime_error("list column " + std::string(_columns[pos - 1].name) + " has a partial element");
+            }
+            field.size = uint32_t(packed.size() / sizeof(T));
+            field.data = packed.data();
+        }
+
+        private:
+
+        static uint64_t offset(const column_view& col, uint64_t i) {
+            uint64_t result;
+            std::memcpy(&result, reinterpret_cast<const char*>(col.offsets) + i * 8, 8);
+            return result;
+        }
+
+        const column_view& column_at(size_t pos, column_type type) const {
+            if (pos >= _columns.size() || _columns[pos].type != type) {
+                throw std::runtime_error("column file of " + waxlabs_codec::name(_table).to_string() +
+                    " does not match the codec layout");
+            }
+            return _columns[pos];
+        }
+
+        std::string _buffer;
+        uint64_t _contract = 0;
+        uint32_t _last_block = 0;
+        uint64_t _table = 0;
+        uint64_t _rows = 0;
+        std::vector<column_view> _columns;
+    };
+
+    #define WAXLABS_COLUMNS_GET_FIELD(r, ROW, FIELD) tbl.get(pos, i, ROW.FIELD);
+
+    #define WAXLABS_COLUMNS_GET_ROW(TYPE, FIELDS) \
+        inline void get_fields(const table_file& tbl, size_t pos, uint64_t i, waxlabs_codec::TYPE& row) { \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_COLUMNS_GET_FIELD, row, FIELDS) \
+        }
+
+    WAXLABS_COLUMNS_GET_ROW(config, WAXLABS_CONFIG_FIELDS)
+    WAXLABS_COLUMNS_GET_ROW(proposal, WAXLABS_PROPOSAL_FIELDS)
+    WAXLABS_COLUMNS_GET_ROW(mdbody, WAXLABS_MDBODY_FIELDS)
+    WAXLABS_COLUMNS_GET_ROW(deliverable, WAXLABS_DELIVERABLE_FIELDS)
+    WAXLABS_COLUMNS_GET_ROW(account, WAXLABS_ACCOUNT_FIELDS)
+    WAXLABS_COLUMNS_GET_ROW(change, WAXLABS_CHANGE_FIELDS)
+
+    #undef WAXLABS_COLUMNS_GET_ROW
+    #undef WAXLABS_COLUMNS_GET_FIELD
+
+    template<typename Row>
+    inline void pack_decoded(const table_file& tbl, uint64_t i, std::string& out) {
+        Row row;
+        get_fields(tbl, 2, i, row);
+        waxlabs_codec::encode(row, out);
+    }
+
+    //calls f(scope, primary_key, packed) for every row, packed in the contract layout
+    template<typename F>
+    inline void for_each_row(const table_file& tbl, F&& f) {
+        std::string packed;
+        for (uint64_t i = 0; i < tbl.rows(); i++) {
+            uint64_t scope, primary_key;
+            size_t pos = 0;
+            tbl.get(pos, i, scope);
+            tbl.get(pos, i, primary_key);
+            packed.clear();
+            switch (tbl.table()) {
+                case CONFIG: pack_decoded<waxlabs_codec::config>(tbl, i, packed); break;
+                case PROPOSALS: pack_decoded<waxlabs_codec::proposal>(tbl, i, packed); break;
+                case MDBODIES: pack_decoded<waxlabs_codec::mdbody>(tbl, i, packed); break;
+                case DELIVERABLES: pack_decoded<waxlabs_codec::deliverable>(tbl, i, packed); break;
+                case ACCOUNTS: pack_decoded<waxlabs_codec::account>(tbl, i, packed); break;
+                case CHANGES: pack_decoded<waxlabs_codec::change>(tbl, i, packed); break;
+                default: {
+                    std::string_view data;
+                    tbl.get(pos, i, data);
+                    packed.assign(data.data(), data.size());
+                }
+            }
+            f(scope, primary_key, std::string_view(packed));
+        }
+    }
+
+}
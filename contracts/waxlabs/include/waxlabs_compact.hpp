@@ -0,0 +1,255 @@
+// Compact encoding of WAX Labs table rows.
+//
+// Off-chain only: C++17 plus Boost.Preprocessor, no eosio.cdt. A compact
+// layout lists the fields of a waxlabs_fields.hpp row in the same order,
+// each with an encoding:
+//
+//   fixed      as the contract packs it (names, time_point_sec, strings)
+//   varuint    unsigned LEB128 (ids, day counts, uint128 counters)
+//   wax        zigzag varint amount, the WAX symbol is implied
+//   votes      map<name, asset> with the VOTE symbol implied on every amount
+//   pair_high  with the pair_low field after it, two small integers in one
+//   pair_low   byte (high and low nibble). 0xF0 escapes to two raw bytes
+//
+// encode() turns a waxlabs_codec row into compact bytes and fails on an
+// asset of another symbol. decode() reads compact bytes back into the same
+// waxlabs_codec row, so code written against the codec reads compact rows
+// unchanged. view also packs the row back into the contract (ABI) layout
+// for explorers that decode with the contract ABI.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/size.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+
+#include "waxlabs_codec.hpp"
+
+#define WAXLABS_PROPOSAL_COMPACT ((varuint, proposal_id))((fixed, proposer))((pair_high, category))((pair_low, status)) \
+    ((fixed, ballot_name))((fixed, title))((fixed, description))((fixed, image_url))((varuint, estimated_time)) \
+    ((wax, total_requested_funds))((wax, remaining_funds))((pair_high, deliverables))((pair_low, deliverables_completed)) \
+    ((fixed, reviewer))((votes, ballot_results))((fixed, update_ts))((fixed, vote_end_time))((fixed, road_map))
+
+#define WAXLABS_DELIVERABLE_COMPACT ((varuint, deliverable_id))((fixed, status))((wax, requested)) \
+    ((fixed, recipient))((fixed, report))((fixed, review_time))((fixed, small_description))((varuint, days_to_complete))
+
+#define WAXLABS_ACCOUNT_COMPACT ((wax, balance))
+
+#define WAXLABS_STAT_COMPACT ((varuint, key))((fixed, val_name))((varuint, current_count))((varuint, total_count))
+
+namespace waxlabs_compact {
+
+    using waxlabs_codec::reader;
+
+    //raw symbol values, precision in the low byte and the code above it
+    constexpr uint64_t symbol_value(std::string_view code, uint8_t precision) {
+        uint64_t value = 0;
+        for (size_t i = code.size(); i > 0; i--) value = value << 8 | uint8_t(code[i - 1]);
+        return value << 8 | precision;
+    }
+
+    constexpr uint64_t WAX_SYMBOL = symbol_value("WAX", 8);
+    constexpr uint64_t VOTE_SYMBOL = symbol_value("VOTE", 8);
+
+    //field encodings, see above
+    namespace enc {
+        struct fixed {};
+        struct varuint {};
+        struct wax {};
+        struct votes {};
+        struct pair_high {};
+        struct pair_low {};
+    }
+
+    //carries the high half of a pair to its low half, and the first failure
+    struct state {
+        uint8_t high = 0;
+        uint8_t low = 0;
+        bool ok = true;
+    };
+
+    //======================== encoding ========================
+
+    template<typename T>
+    inline void write_varuint(std::string& out, T value) {
+        do {
+            uint8_t byte = uint8_t(value & 0x7f);
+            value >>= 7;
+            out += char(value ? byte | 0x80 : byte);
+        } while (value);
+    }
+
+    inline uint64_t zigzag(int64_t value) {
+        return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+    }
+
+    template<typename T>
+    inline void write(std::string& out, state&, enc::fixed, const T& value) {
+        waxlabs_codec::write(out, value);
+    }
+
+    template<typename T>
+    inline void write(std::string& out, state&, enc::varuint, T value) {
+        write_varuint(out, value);
+    }
+
+    inline void write(std::string& out, state& st, enc::wax, const waxlabs_codec::asset& value) {
+        st.ok = st.ok && value.symbol == WAX_SYMBOL;
+        write_varuint(out, zigzag(value.amount));
+    }
+
+    inline void write(std::string& out, state& st, enc::votes, const waxlabs_codec::list_view<waxlabs_codec::name_asset>& value) {
+        write_varuint(out, value.size);
+        for (uint32_t i = 0; i < value.size; i++) {
+            waxlabs_codec::name_asset entry = value[i];
+            st.ok = st.ok && entry.value.symbol == VOTE_SYMBOL;
+            waxlabs_codec::write(out, entry.key);
+            write_varuint(out, zigzag(entry.value.amount));
+        }
+    }
+
+    inline void write(std::string&, state& st, enc::pair_high, uint8_t value) {
+        st.high = value;
+    }
+
+    inline void write(std::string& out, state& st, enc::pair_low, uint8_t value) {
+        if (st.high < 15 && value < 16) {
+            out += char(st.high << 4 | value);
+        } else {
+            out += char(0xF0);
+            out += char(st.high);
+            out += char(value);
+        }
+    }
+
+    //======================== decoding ========================
+
+    template<typename T>
+    inline T read_varuint(reader& rd) {
+        T value = 0;
+        for (unsigned shift = 0; shift < sizeof(T) * 8 && rd.take(1); shift += 7) {
+            uint8_t byte = uint8_t(*rd.pos++);
+            value |= T(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        rd.ok = false;
+        return 0;
+    }
+
+    inline int64_t unzigzag(uint64_t value) {
+        return int64_t(value >> 1) ^ -int64_t(value & 1);
+    }
+
+    template<typename T>
+    inline void read(reader& rd, state&, std::string&, enc::fixed, T& value) {
+        waxlabs_codec::read(rd, value);
+    }
+
+    template<typename T>
+    inline void read(reader& rd, state&, std::string&, enc::varuint, T& value) {
+        value = read_varuint<T>(rd);
+    }
+
+    inline void read(reader& rd, state&, std::string&, enc::wax, waxlabs_codec::asset& value) {
+        value.amount = unzigzag(read_varuint<uint64_t>(rd));
+        value.symbol = WAX_SYMBOL;
+    }
+
+    //the expanded entries go to scratch, which the row then points into
+    inline void read(reader& rd, state&, std::string& scratch, enc::votes, waxlabs_codec::list_view<waxlabs_codec::name_asset>& value) {
+        uint32_t size = read_varuint<uint32_t>(rd);
+        //every entry takes at least 9 bytes, a larger count is a corrupt row
+        if (!rd.take(size_t(size) * 9)) return;
+        scratch.assign(size_t(size) * sizeof(waxlabs_codec::name_asset), '\0');
+        for (uint32_t i = 0; i < size && rd.ok; i++) {
+            waxlabs_codec::name_asset entry;
+            waxlabs_codec::read(rd, entry.key);
+            entry.value.amount = unzigzag(read_varuint<uint64_t>(rd));
+            entry.value.symbol = VOTE_SYMBOL;
+            std::memcpy(&scratch[i * sizeof(entry)], &entry, sizeof(entry));
+        }
+        value.size = size;
+        value.data = scratch.data();
+    }
+
+    inline void read(reader& rd, state& st, std::string&, enc::pair_high, uint8_t& value) {
+        uint8_t byte = 0;
+        waxlabs_codec::read(rd, byte);
+        if (byte >> 4 == 15) {
+            waxlabs_codec::read(rd, st.high);
+            waxlabs_codec::read(rd, st.low);
+        } else {
+            st.high = byte >> 4;
+            st.low = byte & 0x0f;
+        }
+        value = st.high;
+    }
+
+    inline void read(reader&, state& st, std::string&, enc::pair_low, uint8_t& value) {
+        value = st.low;
+    }
+
+    #define WAXLABS_COMPACT_WRITE_FIELD(r, ROW, FIELD) \
+        write(out, st, enc::BOOST_PP_TUPLE_ELEM(2, 0, FIELD){}, ROW.BOOST_PP_TUPLE_ELEM(2, 1, FIELD));
+
+    #define WAXLABS_COMPACT_READ_FIELD(r, ROW, FIELD) \
+        read(rd, st, scratch, enc::BOOST_PP_TUPLE_ELEM(2, 0, FIELD){}, ROW.BOOST_PP_TUPLE_ELEM(2, 1, FIELD));
+
+    //encode appends the compact row to out, false when an asset has another symbol.
+    //decode may point the row into scratch as well as into data
+    #define WAXLABS_COMPACT_CODEC(TYPE, FIELDS, COMPACT) \
+        static_assert(BOOST_PP_SEQ_SIZE(FIELDS) == BOOST_PP_SEQ_SIZE(COMPACT), "compact layout must list every field"); \
+        inline bool encode(const waxlabs_codec::TYPE& row, std::string& out) { \
+            state st; \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_COMPACT_WRITE_FIELD, row, COMPACT) \
+            return st.ok; \
+        } \
+        inline bool decode(const char* data, size_t size, waxlabs_codec::TYPE& row, std::string& scratch) { \
+            reader rd{data, data + size}; \
+            state st; \
+            BOOST_PP_SEQ_FOR_EACH(WAXLABS_COMPACT_READ_FIELD, row, COMPACT) \
+            return rd.ok && rd.pos == rd.end; \
+        }
+
+    WAXLABS_COMPACT_CODEC(proposal, WAXLABS_PROPOSAL_FIELDS, WAXLABS_PROPOSAL_COMPACT)
+    WAXLABS_COMPACT_CODEC(deliverable, WAXLABS_DELIVERABLE_FIELDS, WAXLABS_DELIVERABLE_COMPACT)
+    WAXLABS_COMPACT_CODEC(account, WAXLABS_ACCOUNT_FIELDS, WAXLABS_ACCOUNT_COMPACT)
+    WAXLABS_COMPACT_CODEC(stat, WAXLABS_STAT_FIELDS, WAXLABS_STAT_COMPACT)
+
+    #undef WAXLABS_COMPACT_CODEC
+    #undef WAXLABS_COMPACT_READ_FIELD
+    #undef WAXLABS_COMPACT_WRITE_FIELD
+
+    //a compact row read back in the contract layout
+    template<typename Row>
+    class view {
+        public:
+
+        //false when data is not a compact Row
+        bool load(const char* data, size_t size) {
+            _packed.clear();
+            return decode(data, size, _row, _scratch);
+        }
+
+        //valid until the next load, strings point into the loaded data
+        const Row& row() const { return _row; }
+
+        //the row packed as the contract stores it, for ABI decoders
+        std::string_view packed() {
+            if (_packed.empty()) waxlabs_codec::encode(_row, _packed);
+            return _packed;
+        }
+
+        private:
+
+        Row _row;
+        std::string _scratch;
+        std::string _packed;
+    };
+
+}
@@ -0,0 +1,93 @@
+// Serialization field order of the WAX Labs table rows and action parameters.
+//
+// Row lists are used by EOSLIB_SERIALIZE in waxlabs.hpp and by the native
+// decoders in waxlabs_codec.hpp, so on-chain layout and off-chain decoding
+// share one list. Appending a field here changes the row layout of the table.
+//
+// Parameter lists hold (type, name) pairs. waxlabs.hpp declares the actions
+// from them, waxlabs.cpp defines them with the same lists and
+// waxlabs_client.hpp generates its argument structs from them,
+// so a client packs the arguments in the order the contract unpacks them.
+// Types are spelled as in waxlabs.hpp (string, optional, vector, name, asset).
+
+#pragma once
+
+#include <boost/preprocessor/punctuation/comma_if.hpp>
+#include <boost/preprocessor/seq/for_each.hpp>
+#include <boost/preprocessor/seq/for_each_i.hpp>
+#include <boost/preprocessor/seq/transform.hpp>
+#include <boost/preprocessor/tuple/elem.hpp>
+
+#define WAXLABS_CONFIG_FIELDS (contract_name)(contract_version)(admin_acct)(admin_auth)(last_proposal_id) \
+    (available_funds)(reserved_funds)(deposited_funds)(paid_funds) \
+    (vote_duration)(quorum_threshold_bps)(yes_threshold_bps) \
+    (min_requested)(max_requested)(categories)(cat_deprecated)
+
+#define WAXLABS_PROPOSAL_FIELDS (proposal_id)(proposer)(category)(status)(ballot_name) \
+    (title)(description)(image_url)(estimated_time)(total_requested_funds)(remaining_funds) \
+    (deliverables)(deliverables_completed)(reviewer)(ballot_results) \
+    (update_ts)(vote_end_time)(road_map)
+
+#define WAXLABS_MDBODY_FIELDS (proposal_id)(content)
+
+#define WAXLABS_DELIVERABLE_FIELDS (deliverable_id)(status)(requested) \
+    (recipient)(report)(review_time)(small_description)(days_to_complete)
+
+#define WAXLABS_STAT_FIELDS (key)(val_name)(current_count)(total_count)
+
+#define WAXLABS_ACCOUNT_FIELDS (balance)
+
+#define WAXLABS_CHANGE_FIELDS (seq)(table_name)(scope)(key)(op)(change_ts)
+
+//======================== action parameters ========================
+
+#define WAXLABS_DRAFTPROP_PARAMS ((string, title))((string, description))((string, mdbody))((name, proposer)) \
+    ((string, image_url))((uint32_t, estimated_time))((name, category))((string, road_map))
+
+#define WAXLABS_EDITPROP_PARAMS ((uint64_t, proposal_id))((optional<string>, title)) \
+    ((optional<string>, description))((optional<string>, mdbody))((optional<name>, category)) \
+    ((string, image_url))((uint32_t, estimated_time))((optional<string>, road_map))
+
+#define WAXLABS_SUBMITPROP_PARAMS ((uint64_t, proposal_id))
+#define WAXLABS_REVIEWPROP_PARAMS ((uint64_t, proposal_id))((bool, approve))((string, memo))
+#define WAXLABS_SKIPVOTING_PARAMS ((uint64_t, proposal_id))((string, memo))
+#define WAXLABS_PROPOSAL_REVIEW_PARAMS ((uint64_t, proposal_id))((name, decision))((string, memo))
+#define WAXLABS_REVIEWPROPS_PARAMS ((vector<proposal_review>, reviews))
+#define WAXLABS_BEGINVOTING_PARAMS ((uint64_t, proposal_id))((name, ballot_name))
+#define WAXLABS_ENDVOTING_PARAMS ((uint64_t, proposal_id))
+#define WAXLABS_SETREVIEWER_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((name, new_reviewer))
+#define WAXLABS_CANCELPROP_PARAMS ((uint64_t, proposal_id))((string, memo))
+#define WAXLABS_DELETEPROP_PARAMS ((uint64_t, proposal_id))
+
+#define WAXLABS_NEWDELIV_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((asset, requested_amount)) \
+    ((name, recipient))((string, small_description))((uint32_t, days_to_complete))
+
+#define WAXLABS_RMVDELIV_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))
+
+#define WAXLABS_EDITDELIV_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((asset, new_requested_amount)) \
+    ((name, new_recipient))((string, small_description))((uint32_t, days_to_complete))
+
+#define WAXLABS_SUBMITREPORT_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((string, report))
+#define WAXLABS_REVIEWDELIV_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((bool, accept))((string, memo))
+#define WAXLABS_CLAIMFUNDS_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))
+#define WAXLABS_SETDREVIEWER_PARAMS ((uint64_t, proposal_id))((uint64_t, deliverable_id))((name, new_reviewer))
+
+//newprofile and editprofile take the same arguments
+#define WAXLABS_PROFILE_PARAMS ((name, wax_account))((string, full_name))((string, country))((string, bio)) \
+    ((string, image_url))((string, website))((string, contact))((string, group_name))
+
+#define WAXLABS_RMVPROFILE_PARAMS ((name, wax_account))
+#define WAXLABS_WITHDRAW_PARAMS ((name, account_owner))((asset, quantity))
+#define WAXLABS_REFUNDSLOTS_PARAMS ((name, account_owner))
+
+//type list to a comma separated parameter declaration list
+#define WAXLABS_PARAM_DECL(r, DATA, I, PARAM) BOOST_PP_COMMA_IF(I) BOOST_PP_TUPLE_ELEM(2, 0, PARAM) BOOST_PP_TUPLE_ELEM(2, 1, PARAM)
+#define WAXLABS_PARAMS(PARAMS) BOOST_PP_SEQ_FOR_EACH_I(WAXLABS_PARAM_DECL, _, PARAMS)
+
+//type list to member declarations
+#define WAXLABS_MEMBER_DECL(r, DATA, PARAM) BOOST_PP_TUPLE_ELEM(2, 0, PARAM) BOOST_PP_TUPLE_ELEM(2, 1, PARAM);
+#define WAXLABS_MEMBERS(PARAMS) BOOST_PP_SEQ_FOR_EACH(WAXLABS_MEMBER_DECL, _, PARAMS)
+
+//type list to a field list, as used by EOSLIB_SERIALIZE
+#define WAXLABS_PARAM_NAME(s, DATA, PARAM) BOOST_PP_TUPLE_ELEM(2, 1, PARAM)
+#define WAXLABS_NAMES(PARAMS) BOOST_PP_SEQ_TRANSFORM(WAXLABS_PARAM_NAME, _, PARAMS)
@@ -0,0 +1,55 @@
+// Key encodings of the WAX Labs proposals and dreviewers tables.
+//
+// Plain C++ without eosio.cdt dependencies, so off-chain indexers can include
+// this header and keep the exact orderings of waxlabs::proposals_table and
+// waxlabs::dreviewers_table.
+
+#pragma once
+
+#include <cstdint>
+
+namespace waxlabs_keys {
+
+    typedef unsigned __int128 key128_t;
+
+    // bystatcat: bits 63-56 status, bits 55-48 category, bits 31-0 proposal_id
+    constexpr uint64_t status_category(uint8_t status, uint8_t category, uint64_t proposal_id) {
+        return ((uint64_t)status << 56)|((uint64_t)category << 48)|proposal_id;
+    }
+
+    // bycatstat: bits 63-56 category, bits 55-48 status, bits 31-0 proposal_id
+    constexpr uint64_t category_status(uint8_t category, uint8_t status, uint64_t proposal_id) {
+        return ((uint64_t)category << 56)|((uint64_t)status << 48)|proposal_id;
+    }
+
+    // byproposer / byreviewer: upper 64 bits account, bits 63-56 status, bits 31-0 proposal_id
+    constexpr key128_t account_status(uint64_t account, uint8_t status, uint64_t proposal_id) {
+        return ((key128_t)account << 64)|((key128_t)status << 56)|((key128_t)proposal_id);
+    }
+
+    // byupdatets: upper 32 bits update_ts seconds, lower 32 bits proposal_id
+    constexpr uint64_t update_ts(uint32_t sec_since_epoch, uint64_t proposal_id) {
+        return ((uint64_t)sec_since_epoch << 32)|proposal_id;
+    }
+
+    // dreviewers primary key: upper 32 bits proposal_id, lower 32 bits deliverable_id
+    constexpr uint64_t deliverable(uint64_t proposal_id, uint64_t deliverable_id) {
+        return (proposal_id << 32)|(deliverable_id & 0xFFFFFFFF);
+    }
+
+    // dreviewers byreviewer: upper 64 bits account, lower 64 bits dreviewers primary key
+    constexpr key128_t account_deliverable(uint64_t account, uint64_t deliverable_key) {
+        return ((key128_t)account << 64)|((key128_t)deliverable_key);
+    }
+
+    // first byproposer / byreviewer key of an account, on proposals or dreviewers
+    constexpr key128_t account_lower_bound(uint64_t account) {
+        return (key128_t)account << 64;
+    }
+
+    // last byproposer / byreviewer key of an account, on proposals or dreviewers
+    constexpr key128_t account_upper_bound(uint64_t account) {
+        return account_lower_bound(account) | (key128_t)UINT64_MAX;
+    }
+
+}
@@ -0,0 +1,273 @@
+// Signing and pushing of native WAX Labs transactions.
+//
+// Off-chain only: C++17 plus Boost.Beast, no eosio.cdt. Completes
+// waxlabs_client.hpp: the reference block comes from get_info, the digest
+// of signing_data() is signed by keosd with sign_digest, and the packed
+// transaction is sent to send_transaction over a keep-alive connection.
+// Responses are read with small string scanners for the few members the
+// tools need, not a JSON parser. Only http:// urls are supported.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include "waxlabs_client.hpp"
+
+namespace waxlabs_push {
+
+    namespace asio = boost::asio;
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    using tcp = asio::ip::tcp;
+
+    using waxlabs_client::hex;
+    using waxlabs_client::transaction_header;
+
+    //transactions expire this long after the head block time
+    constexpr uint32_t EXPIRATION_SECONDS = 300;
+
+    //======================== sha256 ========================
+
+    //sha256 of data as 32 raw bytes, the digest keosd signs
+    inline std::string sha256(std::string_view data) {
+        static constexpr uint32_t k[64] = {
+            0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+            0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+            0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+            0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+            0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+            0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+            0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+            0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+        };
+        uint32_t h[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+        auto rotr = [](uint32_t x, int n) { return (x >> n) | (x << (32 - n)); };
+
+        //message, 0x80, zero padding, 64 bit big endian bit length
+        std::string msg(data);
+        uint64_t bits = uint64_t(data.size()) * 8;
+        msg.push_back(char(0x80));
+        while (msg.size() % 64 != 56) msg.push_back('\0');
+        for (int i = 7; i >= 0; i--) msg.push_back(char(bits >> (i * 8)));
+
+        for (size_t block = 0; block < msg.size(); block += 64) {
+            uint32_t w[64];
+            for (int i = 0; i < 16; i++) {
+                const auto* p = reinterpret_cast<const uint8_t*>(msg.data() + block + i * 4);
+                w[i] = uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+            }
+            for (int i = 16; i < 64; i++) {
+                uint32_t s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+                uint32_t s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+                w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+            }
+            uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4], f = h[5], g = h[6], hh = h[7];
+            for (int i = 0; i < 64; i++) {
+                uint32_t t1 = hh + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + ((e & f) ^ (~e & g)) + k[i] + w[i];
+                uint32_t t2 = (rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+                hh = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+            }
+            h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+        }
+
+        std::string out;
+        for (uint32_t word : h) {
+            for (int i = 3; i >= 0; i--) out.push_back(char(word >> (i * 8)));
+        }
+        return out;
+    }
+
+    //======================== http ========================
+
+    struct endpoint {
+        std::string host;
+        std::string port;
+    };
+
+    inline endpoint parse_url(std::string url) {
+        if (url.rfind("http://", 0) != 0) {
+            throw std::runtime_error("only http:// urls are supported: " + url);
+        }
+        url = url.substr(7, url.find('/', 7) == std::string::npos ? std::string::npos : url.find('/', 7) - 7);
+        auto colon = url.find(':');
+        if (colon == std::string::npos) return endpoint{url, "80"};
+        return endpoint{url.substr(0, colon), url.substr(colon + 1)};
+    }
+
+    //keep-alive connection, reconnects once when the server closed it
+    class connection {
+        public:
+
+        explicit connection(endpoint ep) : _ep(std::move(ep)), _stream(_ioc) {}
+
+        //posts body to target, returns the status code and fills response
+        unsigned post(const std::string& target, const std::string& body, std::string& response) {
+            for (int attempt = 0; ; attempt++) {
+                try {
+                    if (!_connected) {
+                        tcp::resolver resolver(_ioc);
+                        _stream.connect(resolver.resolve(_ep.host, _ep.port));
+                        //header and body go out as separate writes, don't hold the body back for an ack
+                        _stream.socket().set_option(tcp::no_delay(true));
+                        _connected = true;
+                    }
+                    http::request<http::string_body> req{http::verb::post, target, 11};
+                    req.set(http::field::host, _ep.host);
+                    req.set(http::field::content_type, "application/json");
+                    req.keep_alive(true);
+                    req.body() = body;
+                    req.prepare_payload();
+                    http::write(_stream, req);
+
+                    beast::flat_buffer buffer;
+                    http::response<http::string_body> res;
+                    http::read(_stream, buffer, res);
+                    if (!res.keep_alive()) {
+                        close();
+                    }
+                    response = std::move(res.body());
+                    return res.result_int();
+                } catch (const std::exception&) {
+                    close();
+                    if (attempt > 0) throw;
+                }
+            }
+        }
+
+        private:
+
+        void close() {
+            beast::error_code ec;
+            _stream.socket().close(ec);
+            _connected = false;
+        }
+
+        endpoint _ep;
+        asio::io_context _ioc;
+        beast::tcp_stream _stream;
+        bool _connected = false;
+    };
+
+    //value of the first "key": string member, empty when missing
+    inline std::string json_string(const std::string& json, const std::string& key, size_t from = 0) {
+        auto pos = json.find("\"" + key + "\"", from);
+        if (pos == std::string::npos) return "";
+        pos = json.find('"', json.find(':', pos) + 1);
+        if (pos == std::string::npos) return "";
+        auto end = json.find('"', pos + 1);
+        return end == std::string::npos ? "" : json.substr(pos + 1, end - pos - 1);
+    }
+
+    //value of the first "key": number member, 0 when missing
+    inline uint64_t json_number(const std::string& json, const std::string& key, size_t from = 0) {
+        auto pos = json.find("\"" + key + "\"", from);
+        if (pos == std::string::npos) return 0;
+        pos = json.find_first_not_of(" \"", json.find(':', pos) + 1);
+        return pos == std::string::npos ? 0 : std::strtoull(json.c_str() + pos, nullptr, 10);
+    }
+
+    //every "key": string member in order, with \n, \t, \" and \\ unescaped
+    inline std::vector<std::string> json_strings(const std::string& json, const std::string& key) {
+        std::vector<std::string> values;
+        std::string pattern = "\"" + key + "\":\"";
+        for (auto pos = json.find(pattern); pos != std::string::npos; pos = json.find(pattern, pos)) {
+            std::string value;
+            for (pos += pattern.size(); pos < json.size() && json[pos] != '"'; pos++) {
+                if (json[pos] == '\\' && pos + 1 < json.size()) {
+                    char c = json[++pos];
+                    value.push_back(c == 'n' ? '\n' : c == 't' ? '\t' : c);
+                } else {
+                    value.push_back(json[pos]);
+                }
+            }
+            values.push_back(std::move(value));
+        }
+        return values;
+    }
+
+    //first error message of a chain api error response
+    inline std::string error_message(const std::string& json) {
+        auto details = json.find("\"details\"");
+        std::string message = json_string(json, "message", details == std::string::npos ? 0 : details);
+        return message.empty() ? json.substr(0, 200) : message;
+    }
+
+    inline std::string unhex(const std::string& hex_str) {
+        std::string out;
+        for (size_t i = 0; i + 1 < hex_str.size(); i += 2) {
+            out.push_back(char(std::stoul(hex_str.substr(i, 2), nullptr, 16)));
+        }
+        return out;
+    }
+
+    //======================== push ========================
+
+    struct chain_state {
+        std::string chain_id; //raw bytes
+        transaction_header header;
+    };
+
+    //reference block and expiration from the last irreversible block
+    inline chain_state get_chain_state(const endpoint& nodeos) {
+        connection conn(nodeos);
+        std::string info;
+        if (conn.post("/v1/chain/get_info", "{}", info) != 200) {
+            throw std::runtime_error("get_info failed: " + info.substr(0, 200));
+        }
+        chain_state state;
+        state.chain_id = unhex(json_string(info, "chain_id"));
+        std::string lib_id = unhex(json_string(info, "last_irreversible_block_id"));
+        std::string head_time = json_string(info, "head_block_time");
+        if (state.chain_id.size() != 32 || lib_id.size() != 32 || head_time.empty()) {
+            throw std::runtime_error("unexpected get_info response: " + info.substr(0, 200));
+        }
+
+        std::tm tm{};
+        if (std::sscanf(head_time.c_str(), "%d-%d-%dT%d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+            &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+            throw std::runtime_error("unexpected head_block_time: " + head_time);
+        }
+        tm.tm_year -= 1900;
+        tm.tm_mon -= 1;
+
+        //block number is the first 4 bytes of the id, big endian
+        uint32_t lib_num = uint32_t(uint8_t(lib_id[0])) << 24 | uint32_t(uint8_t(lib_id[1])) << 16 |
+            uint32_t(uint8_t(lib_id[2])) << 8 | uint8_t(lib_id[3]);
+        state.header.expiration = uint32_t(timegm(&tm)) + EXPIRATION_SECONDS;
+        state.header.ref_block_num = uint16_t(lib_num & 0xffff);
+        std::memcpy(&state.header.ref_block_prefix, lib_id.data() + 8, 4);
+        return state;
+    }
+
+    //keosd signature of packed as a json string, throws when keosd refuses
+    inline std::string sign(connection& wallet, const chain_state& state, const std::string& pubkey, std::string_view packed) {
+        std::string digest = hex(sha256(waxlabs_client::signing_data(state.chain_id, packed)));
+        std::string signature;
+        unsigned status = wallet.post("/v1/wallet/sign_digest", "[\"" + digest + "\",\"" + pubkey + "\"]", signature);
+        if (status / 100 != 2 || signature.rfind("\"SIG_", 0) != 0) {
+            throw std::runtime_error("sign_digest: " + error_message(signature));
+        }
+        return signature;
+    }
+
+    //sends a signed transaction, returns the status code and fills response
+    inline unsigned send(connection& chain, const std::string& signature, std::string_view packed, std::string& response) {
+        std::string body = "{\"signatures\":[" + signature + "],\"compression\":\"none\","
+            "\"packed_context_free_data\":\"\",\"packed_trx\":\"" + hex(packed) + "\"}";
+        return chain.post("/v1/chain/send_transaction", body, response);
+    }
+
+}
@@ -0,0 +1,382 @@
+// Cached HTML rendering of WAX Labs proposal markdown.
+//
+// Off-chain only: C++17 plus the waxlabs_store dependencies, no eosio.cdt.
+// render_markdown() turns mdbodies.content and proposals.road_map into HTML
+// from a small markdown subset: headings, paragraphs, lists, quotes, code,
+// emphasis and links. Every byte of text goes through escape_html(), so raw
+// HTML in the markdown is shown, never interpreted. Links keep only http,
+// https, mailto and relative urls. Input longer than the contract limit is
+// refused rather than rendered.
+//
+// cache keeps the HTML of every proposal requested, tagged with the
+// proposal's update_ts. refresh() follows the contract changes feed that the
+// store mirrors and marks the entries of changed proposals stale. A stale
+// entry is checked against the store on its next get(). A new update_ts
+// renders again only the inputs whose hash changed, so each (proposal_id,
+// update_ts) version is rendered at most once.
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "waxlabs_codec.hpp"
+#include "waxlabs_store.hpp"
+
+namespace waxlabs_render {
+
+    constexpr uint64_t CHANGES = waxlabs_codec::name("changes").value;
+    constexpr uint64_t MDBODIES = waxlabs_codec::name("mdbodies").value;
+
+    //same as MAX_BODY_LEN and MAX_ROAD_MAP_LEN in waxlabs.hpp
+    constexpr size_t MAX_BODY_LEN = 4096;
+    constexpr size_t MAX_ROAD_MAP_LEN = 2048;
+
+    constexpr uint8_t CHANGE_ERASE = 3;
+
+    //======================== sanitizer ========================
+
+    //appends text with the HTML special characters escaped, control bytes other than tab and newline dropped
+    inline void escape_html(std::string_view text, std::string& out) {
+        for (char c : text) {
+            switch (c) {
+                case '&': out += "&amp;"; break;
+                case '<': out += "&lt;"; break;
+                case '>': out += "&gt;"; break;
+                case '"': out += "&quot;"; break;
+                case '\'': out += "&#39;"; break;
+                default:
+                    if (uint8_t(c) >= 0x20 || c == '\n' || c == '\t') out += c;
+            }
+        }
+    }
+
+    //http, https and mailto urls, and relative paths and fragments. no whitespace, control bytes or other schemes
+    inline bool safe_url(std::string_view url) {
+        if (url.empty() || url.rfind("//", 0) == 0) {
+            return false;
+        }
+        for (char c : url) {
+            if (uint8_t(c) <= 0x20 || c == 0x7f || c == '\\') return false;
+        }
+        size_t colon = url.find(':');
+        size_t path = url.find_first_of("/?#");
+        if (colon == std::string_view::npos || (path != std::string_view::npos && path < colon)) {
+            return true;
+        }
+        std::string scheme;
+        for (char c : url.substr(0, colon)) scheme += (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+        return scheme == "http" || scheme == "https" || scheme == "mailto";
+    }
+
+    //======================== markdown ========================
+
+    //emphasis, code spans and links of one line or paragraph
+    inline void render_inline(std::string_view text, std::string& out) {
+        size_t i = 0;
+        while (i < text.size()) {
+            char c = text[i];
+            if (c == '`') {
+                size_t end = text.find('`', i + 1);
+                if (end != std::string_view::npos) {
+                    out += "<code>";
+                    escape_html(text.substr(i + 1, end - i - 1), out);
+                    out += "</code>";
+                    i = end + 1;
+                    continue;
+                }
+            } else if ((c == '*' || c == '_') && i + 1 < text.size() && text[i + 1] == c) {
+                size_t end = text.find(std::string(2, c), i + 2);
+                if (end != std::string_view::npos && end > i + 2) {
+                    out += "<strong>";
+                    render_inline(text.substr(i + 2, end - i - 2), out);
+                    out += "</strong>";
+                    i = end + 2;
+                    continue;
+                }
+            } else if (c == '*' || c == '_') {
+                size_t end = text.find(c, i + 1);
+                if (end != std::string_view::npos && end > i + 1) {
+                    out += "<em>";
+                    render_inline(text.substr(i + 1, end - i - 1), out);
+                    out += "</em>";
+                    i = end + 1;
+                    continue;
+                }
+            } else if (c == '[') {
+                size_t close = text.find("](", i + 1);
+                size_t end = close == std::string_view::npos ? close : text.find(')', close + 2);
+                if (end != std::string_view::npos) {
+                    std::string_view label = text.substr(i + 1, close - i - 1);
+                    std::string_view url = text.substr(close + 2, end - close - 2);
+                    if (safe_url(url)) {
+                        out += "<a href=\"";
+                        escape_html(url, out);
+                        out += "\" rel=\"nofollow noopener noreferrer\">";
+                        render_inline(label, out);
+                        out += "</a>";
+                    } else {
+                        render_inline(label, out);
+                    }
+                    i = end + 1;
+                    continue;
+                }
+            }
+            escape_html(text.substr(i, 1), out);
+            i++;
+        }
+    }
+
+    //HTML of a markdown document
+    inline std::string render_markdown(std::string_view markdown) {
+        std::string out;
+        std::string paragraph;
+        std::string_view list; //"ul" or "ol" while a list is open
+        bool code = false;
+
+        auto close_paragraph = [&]() {
+            if (paragraph.empty()) return;
+            out += "<p>";
+            render_inline(paragraph, out);
+            out += "</p>\n";
+            paragraph.clear();
+        };
+        auto close_list = [&]() {
+            if (list.empty()) return;
+            out += "</";
+            out += list;
+            out += ">\n";
+            list = {};
+        };
+        auto open_list = [&](std::string_view tag) {
+            if (list == tag) return;
+            close_list();
+            out += "<";
+            out += tag;
+            out += ">\n";
+            list = tag;
+        };
+
+        size_t pos = 0;
+        while (pos <= markdown.size()) {
+            size_t end = markdown.find('\n', pos);
+            if (end == std::string_view::npos) end = markdown.size();
+            std::string_view line = markdown.substr(pos, end - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            pos = end + 1;
+
+            if (line.rfind("```", 0) == 0) {
+                if (code) {
+                    out += "</code></pre>\n";
+                } else {
+                    close_paragraph();
+                    close_list();
+                    out += "<pre><code>";
+                }
+                code = !code;
+                continue;
+            }
+            if (code) {
+                escape_html(line, out);
+                out += '\n';
+                continue;
+            }
+
+            size_t indent = line.find_first_not_of(' ');
+            std::string_view body = indent == std::string_view::npos ? std::string_view() : line.substr(indent);
+            if (body.empty()) {
+                close_paragraph();
+                close_list();
+                continue;
+            }
+
+            size_t level = body.find_first_not_of('#');
+            size_t digits = body.find_first_not_of("0123456789");
+            if (level >= 1 && level <= 6 && level < body.size() && body[level] == ' ') {
+                close_paragraph();
+                close_list();
+                std::string tag = "h" + std::to_string(level);
+                out += "<" + tag + ">";
+                render_inline(body.substr(level + 1), out);
+                out += "</" + tag + ">\n";
+            } else if (body.size() > 2 && (body[0] == '-' || body[0] == '*' || body[0] == '+') && body[1] == ' ') {
+                close_paragraph();
+                open_list("ul");
+                out += "<li>";
+                render_inline(body.substr(2), out);
+                out += "</li>\n";
+            } else if (digits > 0 && digits != std::string_view::npos && digits + 1 < body.size() &&
+                body[digits] == '.' && body[digits + 1] == ' ') {
+                close_paragraph();
+                open_list("ol");
+                out += "<li>";
+                render_inline(body.substr(digits + 2), out);
+                out += "</li>\n";
+            } else if (body[0] == '>') {
+                close_paragraph();
+                close_list();
+                out += "<blockquote>";
+                render_inline(body.substr(body.size() > 1 && body[1] == ' ' ? 2 : 1), out);
+                out += "</blockquote>\n";
+            } else {
+                close_list();
+                if (!paragraph.empty()) paragraph += '\n';
+                paragraph += body;
+            }
+        }
+        if (code) {
+            out += "</code></pre>\n";
+        }
+        close_paragraph();
+        close_list();
+        return out;
+    }
+
+    //======================== cache ========================
+
+    inline uint64_t fnv1a(std::string_view text) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : text) {
+            hash = (hash ^ uint8_t(c)) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    struct rendered {
+        uint32_t update_ts = 0; //proposal version the entry was checked against
+        uint64_t body_hash = 0;
+        uint64_t road_map_hash = 0;
+        std::string body_html;
+        std::string road_map_html;
+        bool body_too_long = false; //the input was over the limit and was not rendered
+        bool road_map_too_long = false;
+    };
+
+    class cache {
+        public:
+
+        //marks the entries named by new changes entries stale, the caller holds the store's read lock
+        //returns the number of entries marked or dropped
+        size_t refresh(const waxlabs_store::store& st) {
+            const auto& rows = st.rows();
+            uint64_t contract = st.state().contract;
+
+            //the contract pruned entries this cache never saw, check every entry again
+            auto first = rows.lower_bound(boost::make_tuple(CHANGES, contract, uint64_t(0)));
+            bool has_changes = first != rows.end() && first->table == CHANGES && first->scope == contract;
+            if (!_synced || (has_changes && first->primary_key > _next_seq)) {
+                for (auto& entry : _entries) entry.second.stale = true;
+                _next_seq = 0;
+                auto last = rows.upper_bound(boost::make_tuple(CHANGES, contract));
+                if (last != rows.begin() && (--last)->table == CHANGES && last->scope == contract) {
+                    _next_seq = last->primary_key + 1;
+                }
+                _synced = true;
+                return _entries.size();
+            }
+
+            size_t marked = 0;
+            for (auto itr = rows.lower_bound(boost::make_tuple(CHANGES, contract, _next_seq));
+                itr != rows.end() && itr->table == CHANGES && itr->scope == contract; ++itr) {
+                waxlabs_codec::change chg;
+                if (!waxlabs_codec::decode(itr->data.data(), itr->data.size(), chg)) {
+                    throw std::runtime_error("changes row does not match the codec layout");
+                }
+                if (chg.table_name == waxlabs_store::PROPOSALS || chg.table_name == MDBODIES) {
+                    auto entry = _entries.find(chg.key);
+                    if (entry != _entries.end()) {
+                        if (chg.table_name == waxlabs_store::PROPOSALS && chg.op == CHANGE_ERASE) {
+                            _entries.erase(entry);
+                        } else {
+                            entry->second.stale = true;
+                        }
+                        marked++;
+                    }
+                }
+                _next_seq = chg.seq + 1;
+            }
+            return marked;
+        }
+
+        //HTML of a proposal, nullptr when the store has no such proposal. the caller holds the read lock
+        //and should call refresh() first. the entry stays valid until the next refresh() or get()
+        const rendered* get(const waxlabs_store::store& st, uint64_t proposal_id) {
+            auto itr = _entries.find(proposal_id);
+            if (itr != _entries.end() && !itr->second.stale) {
+                _hits++;
+                return &itr->second.html;
+            }
+
+            const auto& by_pk = st.proposals().get<waxlabs_store::by_id>();
+            auto prop_itr = by_pk.find(proposal_id);
+            if (prop_itr == by_pk.end()) {
+                if (itr != _entries.end()) _entries.erase(itr);
+                return nullptr;
+            }
+            waxlabs_codec::proposal prop;
+            if (!waxlabs_codec::decode(prop_itr->data.data(), prop_itr->data.size(), prop)) {
+                throw std::runtime_error("proposals row does not match the codec layout");
+            }
+            waxlabs_codec::mdbody body{proposal_id, {}};
+            if (auto packed = st.find(MDBODIES, st.state().contract, proposal_id)) {
+                if (!waxlabs_codec::decode(packed->data(), packed->size(), body)) {
+                    throw std::runtime_error("mdbodies row does not match the codec layout");
+                }
+            }
+
+            bool fresh = itr == _entries.end();
+            if (fresh) {
+                itr = _entries.emplace(proposal_id, entry()).first;
+            }
+            entry& ent = itr->second;
+            ent.stale = false;
+            if (!fresh && ent.html.update_ts == prop.update_ts) {
+                _hits++;
+                return &ent.html;
+            }
+            ent.html.update_ts = prop.update_ts;
+
+            //a new version of the row, render again only the inputs that changed
+            uint64_t body_hash = fnv1a(body.content);
+            if (fresh || body_hash != ent.html.body_hash) {
+                ent.html.body_hash = body_hash;
+                render(body.content, MAX_BODY_LEN, ent.html.body_html, ent.html.body_too_long);
+            }
+            uint64_t road_map_hash = fnv1a(prop.road_map);
+            if (fresh || road_map_hash != ent.html.road_map_hash) {
+                ent.html.road_map_hash = road_map_hash;
+                render(prop.road_map, MAX_ROAD_MAP_LEN, ent.html.road_map_html, ent.html.road_map_too_long);
+            }
+            return &ent.html;
+        }
+
+        size_t entries() const { return _entries.size(); }
+        uint64_t renders() const { return _renders; }
+        uint64_t hits() const { return _hits; }
+        uint64_t next_seq() const { return _next_seq; }
+
+        private:
+
+        struct entry {
+            rendered html;
+            bool stale = false;
+        };
+
+        //input over limit is not rendered, it would have been refused on-chain
+        void render(std::string_view markdown, size_t limit, std::string& html, bool& too_long) {
+            too_long = markdown.size() > limit;
+            html = too_long ? std::string() : render_markdown(markdown);
+            _renders++;
+        }
+
+        std::unordered_map<uint64_t, entry> _entries;
+        uint64_t _next_seq = 0; //first changes seq not applied yet
+        uint64_t _renders = 0;
+        uint64_t _hits = 0;
+        bool _synced = false;
+    };
+
+}
@@ -0,0 +1,260 @@
+// Keyword index over WAX Labs proposals.
+//
+// Off-chain only: C++17 plus the waxlabs_store dependencies, no eosio.cdt. The
+// index covers title, description, road_map and the mdbodies content of every
+// proposal in a waxlabs_store. Queries are ranked with BM25 and can filter on
+// the status and category values of the bystatcat and bycatstat keys.
+//
+// The index follows the contract changes feed that the store mirrors. Each
+// refresh() re-reads only the proposals named by changes entries since the
+// previous call. When the contract has pruned entries the index never saw, it
+// rebuilds from the store instead.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "waxlabs_codec.hpp"
+#include "waxlabs_store.hpp"
+
+namespace waxlabs_search {
+
+    constexpr uint64_t CHANGES = waxlabs_codec::name("changes").value;
+    constexpr uint64_t MDBODIES = waxlabs_codec::name("mdbodies").value;
+
+    //a title match counts four times a road_map or body match
+    constexpr uint32_t TITLE_WEIGHT = 4;
+    constexpr uint32_t DESCRIPTION_WEIGHT = 2;
+    constexpr uint32_t TEXT_WEIGHT = 1;
+
+    constexpr size_t MIN_TOKEN_LEN = 2;
+    constexpr size_t MAX_TOKEN_LEN = 32;
+
+    //BM25 parameters
+    constexpr double K1 = 1.2;
+    constexpr double B = 0.75;
+
+    //calls emit with every token of text: runs of letters, digits and non-ascii bytes, lowercased
+    template<typename F>
+    void tokenize(std::string_view text, F&& emit) {
+        std::string token;
+        auto flush = [&]() {
+            if (token.size() >= MIN_TOKEN_LEN) emit(token);
+            token.clear();
+        };
+        for (char c : text) {
+            bool upper = c >= 'A' && c <= 'Z';
+            if (upper || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || uint8_t(c) >= 0x80) {
+                if (token.size() < MAX_TOKEN_LEN) token += upper ? char(c - 'A' + 'a') : c;
+            } else {
+                flush();
+            }
+        }
+        flush();
+    }
+
+    struct filter {
+        std::optional<uint8_t> status;
+        std::optional<uint8_t> category;
+    };
+
+    struct hit {
+        uint64_t proposal_id;
+        double score;
+    };
+
+    class index {
+        public:
+
+        //brings the index up to date with the store, the caller holds the store's read lock
+        //returns the number of proposals indexed again
+        size_t refresh(const waxlabs_store::store& st) {
+            const auto& rows = st.rows();
+            uint64_t contract = st.state().contract;
+
+            auto first = rows.lower_bound(boost::make_tuple(CHANGES, contract, uint64_t(0)));
+            bool has_changes = first != rows.end() && first->table == CHANGES && first->scope == contract;
+            if (!_built || (has_changes && first->primary_key > _next_seq)) {
+                rebuild(st);
+                return _documents.size();
+            }
+
+            //proposals named by new changes entries, erased ones are dropped by reindex
+            std::set<uint64_t> touched;
+            for (auto itr = rows.lower_bound(boost::make_tuple(CHANGES, contract, _next_seq));
+                itr != rows.end() && itr->table == CHANGES && itr->scope == contract; ++itr) {
+                waxlabs_codec::change chg;
+                if (!waxlabs_codec::decode(itr->data.data(), itr->data.size(), chg)) {
+                    throw std::runtime_error("changes row does not match the codec layout");
+                }
+                if (chg.table_name == waxlabs_store::PROPOSALS || chg.table_name == MDBODIES) {
+                    touched.insert(chg.key);
+                }
+                _next_seq = chg.seq + 1;
+            }
+            for (uint64_t proposal_id : touched) {
+                reindex(st, proposal_id);
+            }
+            return touched.size();
+        }
+
+        //indexes every proposal in the store from scratch
+        void rebuild(const waxlabs_store::store& st) {
+            _postings.clear();
+            _documents.clear();
+            _total_length = 0;
+            for (const auto& row : st.proposals()) {
+                reindex(st, row.proposal_id);
+            }
+
+            //continue after the last changes entry in the store
+            const auto& rows = st.rows();
+            uint64_t contract = st.state().contract;
+            _next_seq = 0;
+            auto last = rows.upper_bound(boost::make_tuple(CHANGES, contract));
+            if (last != rows.begin() && (--last)->table == CHANGES && last->scope == contract) {
+                _next_seq = last->primary_key + 1;
+            }
+            _built = true;
+        }
+
+        //best matches of every term in text, highest score first
+        std::vector<hit> query(std::string_view text, const filter& flt, size_t limit) const {
+            std::vector<const postings*> lists;
+            std::set<std::string> seen;
+            bool missing = false;
+            tokenize(text, [&](const std::string& term) {
+                if (!seen.insert(term).second) return;
+                auto itr = _postings.find(term);
+                if (itr == _postings.end()) {
+                    missing = true;
+                } else {
+                    lists.push_back(&itr->second);
+                }
+            });
+            std::vector<hit> hits;
+            if (missing || lists.empty()) {
+                return hits;
+            }
+
+            //candidates come from the shortest list, every other term must match too
+            std::sort(lists.begin(), lists.end(), [](const postings* a, const postings* b) { return a->size() < b->size(); });
+            double documents = double(_documents.size());
+            double average_length = double(_total_length) / documents;
+            for (const auto& candidate : *lists.front()) {
+                const document& doc = _documents.at(candidate.first);
+                if ((flt.status && doc.status != *flt.status) || (flt.category && doc.category != *flt.category)) {
+                    continue;
+                }
+                double score = 0;
+                for (const postings* list : lists) {
+                    auto itr = list->find(candidate.first);
+                    if (itr == list->end()) {
+                        score = -1;
+                        break;
+                    }
+                    double frequency = itr->second;
+                    double idf = std::log(1 + (documents - list->size() + 0.5) / (list->size() + 0.5));
+                    score += idf * frequency * (K1 + 1) / (frequency + K1 * (1 - B + B * doc.length / average_length));
+                }
+                if (score >= 0) {
+                    hits.push_back(hit{candidate.first, score});
+                }
+            }
+
+            auto better = [](const hit& a, const hit& b) {
+                return a.score != b.score ? a.score > b.score : a.proposal_id > b.proposal_id;
+            };
+            size_t count = std::min(limit, hits.size());
+            std::partial_sort(hits.begin(), hits.begin() + count, hits.end(), better);
+            hits.resize(count);
+            return hits;
+        }
+
+        size_t documents() const { return _documents.size(); }
+        size_t terms() const { return _postings.size(); }
+        uint64_t next_seq() const { return _next_seq; }
+
+        private:
+
+        //proposal_id to weighted term frequency
+        typedef std::unordered_map<uint64_t, uint32_t> postings;
+
+        struct document {
+            uint8_t status;
+            uint8_t category;
+            uint32_t length; //sum of weighted term frequencies
+            std::vector<std::string> terms;
+        };
+
+        //indexes a proposal again from the store, or drops it when the row is gone
+        void reindex(const waxlabs_store::store& st, uint64_t proposal_id) {
+            remove(proposal_id);
+
+            const auto& by_pk = st.proposals().get<waxlabs_store::by_id>();
+            auto itr = by_pk.find(proposal_id);
+            if (itr == by_pk.end()) {
+                return;
+            }
+            waxlabs_codec::proposal prop;
+            if (!waxlabs_codec::decode(itr->data.data(), itr->data.size(), prop)) {
+                throw std::runtime_error("proposals row does not match the codec layout");
+            }
+            waxlabs_codec::mdbody body{proposal_id, {}};
+            if (auto packed = st.find(MDBODIES, st.state().contract, proposal_id)) {
+                if (!waxlabs_codec::decode(packed->data(), packed->size(), body)) {
+                    throw std::runtime_error("mdbodies row does not match the codec layout");
+                }
+            }
+
+            std::unordered_map<std::string, uint32_t> frequencies;
+            auto add = [&](std::string_view text, uint32_t weight) {
+                tokenize(text, [&](const std::string& term) { frequencies[term] += weight; });
+            };
+            add(prop.title, TITLE_WEIGHT);
+            add(prop.description, DESCRIPTION_WEIGHT);
+            add(prop.road_map, TEXT_WEIGHT);
+            add(body.content, TEXT_WEIGHT);
+
+            document doc{prop.status, prop.category, 0, {}};
+            doc.terms.reserve(frequencies.size());
+            for (auto& entry : frequencies) {
+                _postings[entry.first][proposal_id] = entry.second;
+                doc.length += entry.second;
+                doc.terms.push_back(entry.first);
+            }
+            _total_length += doc.length;
+            _documents.emplace(proposal_id, std::move(doc));
+        }
+
+        void remove(uint64_t proposal_id) {
+            auto itr = _documents.find(proposal_id);
+            if (itr == _documents.end()) {
+                return;
+            }
+            for (const auto& term : itr->second.terms) {
+                auto list = _postings.find(term);
+                list->second.erase(proposal_id);
+                if (list->second.empty()) _postings.erase(list);
+            }
+            _total_length -= itr->second.length;
+            _documents.erase(itr);
+        }
+
+        std::unordered_map<std::string, postings> _postings;
+        std::unordered_map<uint64_t, document> _documents;
+        uint64_t _total_length = 0;
+        uint64_t _next_seq = 0; //first changes seq not applied yet
+        bool _built = false;
+    };
+
+}
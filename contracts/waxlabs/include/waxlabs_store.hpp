@@ -0,0 +1,230 @@
+// Memory-mapped local store of WAX Labs table rows.
+//
+// Off-chain only: C++17 plus Boost.Interprocess and Boost.MultiIndex, no
+// eosio.cdt. Rows are kept packed, byte for byte as the contract stores them,
+// in a memory-mapped file that survives restarts. proposals rows are also
+// ordered by every secondary key of waxlabs::proposals_table (see
+// waxlabs_keys.hpp), so a reader walks the same orderings as the contract and
+// decodes rows in place with waxlabs_codec.
+//
+// One writer (the indexer) applies a block at a time under the exclusive
+// lock. Readers such as API servers open the same file and hold the sharable
+// lock while they walk an index.
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/containers/vector.hpp>
+#include <boost/interprocess/managed_mapped_file.hpp>
+#include <boost/interprocess/sync/interprocess_sharable_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/sync/sharable_lock.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include "waxlabs_codec.hpp"
+#include "waxlabs_keys.hpp"
+
+namespace waxlabs_store {
+
+    namespace bip = boost::interprocess;
+    namespace bmi = boost::multi_index;
+
+    using segment_manager = bip::managed_mapped_file::segment_manager;
+    using bytes = bip::vector<char, bip::allocator<char, segment_manager>>;
+    using key128_t = waxlabs_keys::key128_t;
+
+    constexpr uint64_t PROPOSALS = waxlabs_codec::name("proposals").value;
+
+    //index tags, named after the proposals_table indices
+    struct by_id;
+    struct bystatcat;
+    struct bycatstat;
+    struct byproposer;
+    struct byreviewer;
+    struct byballot;
+    struct byupdatets;
+
+    //one proposals row with the key of every proposals_table index
+    struct proposal_row {
+        uint64_t proposal_id;
+        uint64_t status_category;
+        uint64_t category_status;
+        key128_t proposer_status;
+        key128_t reviewer_status;
+        uint64_t ballot_name;
+        uint64_t update_ts;
+        bytes data; //packed row
+
+        template<typename Allocator>
+        proposal_row(const Allocator& alloc, const waxlabs_codec::proposal& prop, const char* packed, size_t size)
+            : data(alloc) {
+            set(prop, packed, size);
+        }
+
+        void set(const waxlabs_codec::proposal& prop, const char* packed, size_t size) {
+            proposal_id = prop.proposal_id;
+            status_category = waxlabs_keys::status_category(prop.status, prop.category, prop.proposal_id);
+            category_status = waxlabs_keys::category_status(prop.category, prop.status, prop.proposal_id);
+            proposer_status = waxlabs_keys::account_status(prop.proposer, prop.status, prop.proposal_id);
+            reviewer_status = waxlabs_keys::account_status(prop.reviewer, prop.status, prop.proposal_id);
+            ballot_name = prop.ballot_name;
+            update_ts = waxlabs_keys::update_ts(prop.update_ts, prop.proposal_id);
+            data.assign(packed, packed + size);
+        }
+    };
+
+    typedef bmi::multi_index_container<
+        proposal_row,
+        bmi::indexed_by<
+            bmi::ordered_unique<bmi::tag<by_id>, bmi::member<proposal_row, uint64_t, &proposal_row::proposal_id>>,
+            bmi::ordered_unique<bmi::tag<bystatcat>, bmi::member<proposal_row, uint64_t, &proposal_row::status_category>>,
+            bmi::ordered_unique<bmi::tag<bycatstat>, bmi::member<proposal_row, uint64_t, &proposal_row::category_status>>,
+            bmi::ordered_unique<bmi::tag<byproposer>, bmi::member<proposal_row, key128_t, &proposal_row::proposer_status>>,
+            bmi::ordered_unique<bmi::tag<byreviewer>, bmi::member<proposal_row, key128_t, &proposal_row::reviewer_status>>,
+            //ties broken by primary key, like a multi_index secondary index
+            bmi::ordered_unique<bmi::tag<byballot>, bmi::composite_key<proposal_row,
+                bmi::member<proposal_row, uint64_t, &proposal_row::ballot_name>,
+                bmi::member<proposal_row, uint64_t, &proposal_row::proposal_id>>>,
+            bmi::ordered_unique<bmi::tag<byupdatets>, bmi::member<proposal_row, uint64_t, &proposal_row::update_ts>>
+        >,
+        bip::allocator<proposal_row, segment_manager>
+    > proposal_index;
+
+    //a row of any other contract table
+    struct table_row {
+        uint64_t table;
+        uint64_t scope;
+        uint64_t primary_key;
+        bytes data; //packed row
+
+        template<typename Allocator>
+        table_row(const Allocator& alloc, uint64_t table, uint64_t scope, uint64_t primary_key, const char* packed, size_t size)
+            : table(table), scope(scope), primary_key(primary_key), data(packed, packed + size, alloc) {}
+    };
+
+    //ordered like the chain database: table, scope, primary key
+    typedef bmi::multi_index_container<
+        table_row,
+        bmi::indexed_by<
+            bmi::ordered_unique<bmi::composite_key<table_row,
+                bmi::member<table_row, uint64_t, &table_row::table>,
+                bmi::member<table_row, uint64_t, &table_row::scope>,
+                bmi::member<table_row, uint64_t, &table_row::primary_key>>>
+        >,
+        bip::allocator<table_row, segment_manager>
+    > row_index;
+
+    struct store_state {
+        bip::interprocess_sharable_mutex mutex;
+        uint64_t contract = 0; //account the rows belong to
+        uint32_t last_block = 0; //last block applied, 0 before the first one
+        bool dirty = false; //set while a block is being applied
+    };
+
+    class store {
+        public:
+
+        //opens the store file at path, creating it with size bytes when missing
+        store(const std::string& path, size_t size)
+            : _segment(bip::open_or_create, path.c_str(), size),
+              _state(_segment.find_or_construct<store_state>("state")()),
+              _proposals(_segment.find_or_construct<proposal_index>("proposals")(_segment.get_segment_manager())),
+              _rows(_segment.find_or_construct<row_index>("rows")(_segment.get_segment_manager())) {
+            if (_state->dirty) {
+                throw std::runtime_error("store was left in the middle of a block, rebuild it");
+            }
+        }
+
+        //sharable lock for readers, held while walking an index
+        bip::sharable_lock<bip::interprocess_sharable_mutex> read_lock() const {
+            return bip::sharable_lock<bip::interprocess_sharable_mutex>(_state->mutex);
+        }
+
+        //exclusive lock for the writer, held while applying a block
+        bip::scoped_lock<bip::interprocess_sharable_mutex> write_lock() {
+            return bip::scoped_lock<bip::interprocess_sharable_mutex>(_state->mutex);
+        }
+
+        const store_state& state() const { return *_state; }
+        const proposal_index& proposals() const { return *_proposals; }
+        const row_index& rows() const { return *_rows; }
+
+        //binds an empty store to a contract, a filled one only to the same contract
+        void set_contract(uint64_t contract) {
+            if (_state->contract != 0 && _state->contract != contract) {
+                throw std::runtime_error("store holds the rows of another contract");
+            }
+            _state->contract = contract;
+        }
+
+        //marks the store dirty until commit_block, a crash in between is detected on open
+        void begin_block() {
+            _state->dirty = true;
+        }
+
+        void commit_block(uint32_t block_num) {
+            _state->last_block = block_num;
+            _state->dirty = false;
+        }
+
+        //applies one contract row delta, present is false for an erased row
+        void apply(uint64_t table, uint64_t scope, uint64_t primary_key, bool present, const char* data, size_t size) {
+            if (table == PROPOSALS) {
+                apply_proposal(primary_key, present, data, size);
+                return;
+            }
+            auto itr = _rows->find(boost::make_tuple(table, scope, primary_key));
+            if (!present) {
+                if (itr != _rows->end()) _rows->erase(itr);
+            } else if (itr == _rows->end()) {
+                _rows->emplace(_segment.get_segment_manager(), table, scope, primary_key, data, size);
+            } else {
+                _rows->modify(itr, [&](table_row& row) { row.data.assign(data, data + size); });
+            }
+        }
+
+        //packed row of a table other than proposals, nullptr when missing
+        const bytes* find(uint64_t table, uint64_t scope, uint64_t primary_key) const {
+            auto itr = _rows->find(boost::make_tuple(table, scope, primary_key));
+            return itr == _rows->end() ? nullptr : &itr->data;
+        }
+
+        //bytes of the mapped file still free
+        size_t free_memory() const {
+            return _segment.get_free_memory();
+        }
+
+        private:
+
+        void apply_proposal(uint64_t proposal_id, bool present, const char* data, size_t size) {
+            auto& by_pk = _proposals->get<by_id>();
+            auto itr = by_pk.find(proposal_id);
+            if (!present) {
+                if (itr != by_pk.end()) by_pk.erase(itr);
+                return;
+            }
+            waxlabs_codec::proposal prop;
+            if (!waxlabs_codec::decode(data, size, prop) || prop.proposal_id != proposal_id) {
+                throw std::runtime_error("proposals row does not match the codec layout");
+            }
+            if (itr == by_pk.end()) {
+                by_pk.emplace(_segment.get_segment_manager(), prop, data, size);
+            } else {
+                by_pk.modify(itr, [&](proposal_row& row) { row.set(prop, data, size); });
+            }
+        }
+
+        bip::managed_mapped_file _segment;
+        store_state* _state;
+        proposal_index* _proposals;
+        row_index* _rows;
+    };
+
+}
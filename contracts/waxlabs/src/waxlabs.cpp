@@ -7,11 +7,8 @@ ACTION waxlabs::init(string contract_name, string contract_version, name initial
     //authenticate
     require_auth(get_self());
 
-    //open config singleton
-    config_singleton configs(get_self(), get_self().value);
-
     //validate
-    check(!configs.exists(), "contract already initialized");
+    check(!_configs.exists(), "contract already initialized");
     check(is_account(initial_admin), "initial admin account doesn't exist");
 
     //initialize
@@ -21,14 +18,15 @@ ACTION waxlabs::init(string contract_name, string contract_version, name initial
     initial_conf.admin_acct = initial_admin;
 
     //set initial config
-    configs.set(initial_conf, get_self());
+    _conf = initial_conf;
+    _conf_loaded = true;
+    save_config();
 }
 
 ACTION waxlabs::setversion(string new_version)
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -37,14 +35,13 @@ ACTION waxlabs::setversion(string new_version)
     conf.contract_version = new_version;
 
     //set new config
-    configs.set(conf, get_self());
+    save_config();
 }
 
 ACTION waxlabs::setadmin(name new_admin)
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -56,14 +53,13 @@ ACTION waxlabs::setadmin(name new_admin)
     conf.admin_acct = new_admin;
 
     //set new config
-    configs.set(conf, get_self());
+    save_config();
 }
 
 ACTION waxlabs::setduration(uint32_t new_vote_duration)
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -75,14 +71,13 @@ ACTION waxlabs::setduration(uint32_t new_vote_duration)
     conf.vote_duration = new_vote_duration;
 
     //set new config
-    configs.set(conf, get_self());
+    save_config();
 }
 
 ACTION waxlabs::addcategory(name new_category)
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -102,14 +97,13 @@ ACTION waxlabs::addcategory(name new_category)
     }
 
     //set new config
-    configs.set(conf, get_self());
+    save_config();
 }
 
 ACTION waxlabs::rmvcategory(name category_name)
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -124,24 +118,248 @@ ACTION waxlabs::rmvcategory(name category_name)
     conf.cat_deprecated.push_back(category_name);
 
     //set new config
-    configs.set(conf, get_self());
+    save_config();
+}
+
+ACTION waxlabs::migrateconf()
+{
+    //authenticate
+    require_auth(get_self());
+
+    //read transaction, find setcode of self ahead of this action
+    size_t trx_size = transaction_size();
+    vector<char> trx_buffer(trx_size);
+    read_transaction(trx_buffer.data(), trx_size);
+    auto trx = unpack<transaction>(trx_buffer.data(), trx_size);
+    bool upgraded = false;
+    for (auto& act : trx.actions) {
+        if (act.account == get_self() && act.name == name("migrateconf")) {
+            break;
+        }
+        if (act.account == name("eosio") && act.name == name("setcode") && act.data.size() >= sizeof(uint64_t)
+            && unpack<name>(act.data.data(), sizeof(uint64_t)) == get_self()) {
+            upgraded = true;
+        }
+    }
+    check(upgraded, "migrateconf must follow setcode of this contract in the same transaction");
+
+    //open legacy config singleton, get legacy config
+    legacy_config_singleton legacy_configs(get_self(), get_self().value);
+    check(legacy_configs.exists(), "contract not initialized");
+    auto old_conf = legacy_configs.get();
+
+    //validate
+    //NOTE: a row already in the new layout misaligns when read as doubles and fails these checks.
+    //this only stops a second migration of a converted row, it can't tell which code wrote the row.
+    check(old_conf.quorum_threshold >= 0.0 && old_conf.quorum_threshold <= 100.0, "config is not in legacy layout");
+    check(old_conf.yes_threshold >= 0.0 && old_conf.yes_threshold <= 100.0, "config is not in legacy layout");
+
+    //initialize
+    config new_conf;
+    new_conf.contract_name = old_conf.contract_name;
+    new_conf.contract_version = old_conf.contract_version;
+    new_conf.admin_acct = old_conf.admin_acct;
+    new_conf.admin_auth = old_conf.admin_auth;
+    new_conf.last_proposal_id = old_conf.last_proposal_id;
+    new_conf.available_funds = old_conf.available_funds;
+    new_conf.reserved_funds = old_conf.reserved_funds;
+    new_conf.deposited_funds = old_conf.deposited_funds;
+    new_conf.paid_funds = old_conf.paid_funds;
+    new_conf.vote_duration = old_conf.vote_duration;
+    new_conf.quorum_threshold_bps = static_cast<uint16_t>(old_conf.quorum_threshold * 100 + 0.5);
+    new_conf.yes_threshold_bps = static_cast<uint16_t>(old_conf.yes_threshold * 100 + 0.5);
+    new_conf.min_requested = old_conf.min_requested;
+    new_conf.max_requested = old_conf.max_requested;
+    new_conf.categories = old_conf.categories;
+    new_conf.cat_deprecated = old_conf.cat_deprecated;
+
+    //set new config
+    _configs.set(new_conf, get_self());
+    log_change(name("config"), get_self().value, name("config").value, change_op::modify);
+}
+
+ACTION waxlabs::recompfunds(name category, uint8_t status, uint32_t count)
+{
+    //get config
+    auto& conf = get_config();
+
+    //authenticate
+    require_auth(conf.admin_acct);
+
+    //validate
+    auto cat_itr = std::find(conf.categories.begin(), conf.categories.end(), category);
+    check(cat_itr != conf.categories.end(), "invalid category");
+    check(count > 0, "count must be greater than zero");
+    uint8_t cat_pos = std::distance(conf.categories.begin(), cat_itr);
+
+    //start a scan, or continue the one in progress
+    auto& entry = load_fundstat(cat_pos, status);
+    if (!entry.scanning) {
+        entry.scan = fundscan();
+        entry.scan.category = cat_pos;
+        entry.scan.status = status;
+        entry.scanning = true;
+    }
+    entry.scan_dirty = true;
+
+    //sum up to count proposals of the bucket from the scan cursor
+    proposals_table proposals(get_self(), get_self().value);
+    auto by_cat_stat = proposals.get_index<name("bycatstat")>();
+    auto prop_itr = by_cat_stat.lower_bound(waxlabs_keys::category_status(cat_pos, status, entry.scan.next_id));
+    while (prop_itr != by_cat_stat.end() && prop_itr->category == cat_pos && prop_itr->status == status && count > 0) {
+        entry.scan.proposals += 1;
+        entry.scan.requested += prop_itr->total_requested_funds;
+        entry.scan.remaining += prop_itr->remaining_funds;
+        entry.scan.next_id = prop_itr->proposal_id + 1;
+        count -= 1;
+        prop_itr++;
+    }
+
+    if (prop_itr != by_cat_stat.end() && prop_itr->category == cat_pos && prop_itr->status == status) {
+        print("recompfunds: continue at proposal ", entry.scan.next_id);
+        return;
+    }
+
+    //end of bucket, replace cached aggregate and drop the scan, written on flush
+    entry.row.proposals = entry.scan.proposals;
+    entry.row.requested = entry.scan.requested;
+    entry.row.remaining = entry.scan.remaining;
+    entry.row.drift = 0;
+    entry.dirty = true;
+    entry.scanning = false;
+    print("recompfunds: complete, ", entry.row.proposals, " proposals");
+}
+
+ACTION waxlabs::recompcount(name proposer, uint32_t count)
+{
+    //get config
+    auto& conf = get_config();
+
+    //authenticate
+    require_auth(conf.admin_acct);
+
+    //validate
+    check(count > 0, "count must be greater than zero");
+
+    //start a scan, or continue the one in progress
+    countscans_table countscans(get_self(), get_self().value);
+    auto scan_itr = countscans.find(proposer.value);
+    countscan scan;
+    scan.proposer = proposer;
+    if (scan_itr != countscans.end()) {
+        scan = *scan_itr;
+    }
+
+    //walk up to count proposals by id from the scan cursor. ids never change, so unlike the
+    //byproposer index the walk can't miss or repeat a proposal whose status changes between calls
+    proposals_table proposals(get_self(), get_self().value);
+    auto prop_itr = proposals.lower_bound(scan.next_id);
+    while (prop_itr != proposals.end() && count > 0) {
+        if (prop_itr->proposer == proposer) {
+            scan.proposals += 1;
+        }
+        scan.next_id = prop_itr->proposal_id + 1;
+        count -= 1;
+        prop_itr++;
+    }
+
+    if (prop_itr != proposals.end()) {
+        //ram payer: self
+        if (scan_itr == countscans.end()) {
+            countscans.emplace(get_self(), [&](auto& col) {
+                col = scan;
+            });
+            log_change(name("countscans"), get_self().value, proposer.value, change_op::insert);
+        } else {
+            countscans.modify(scan_itr, same_payer, [&](auto& col) {
+                col = scan;
+            });
+            log_change(name("countscans"), get_self().value, proposer.value, change_op::modify);
+        }
+        print("recompcount: continue at proposal ", scan.next_id);
+        return;
+    }
+
+    //end of table, drop the scan and replace the current count
+    if (scan_itr != countscans.end()) {
+        log_change(name("countscans"), get_self().value, proposer.value, change_op::erase);
+        countscans.erase(scan_itr);
+    }
+
+    //open propcounts table, find proposer
+    propcounts_table propcounts(get_self(), get_self().value);
+    auto count_itr = propcounts.find(proposer.value);
+
+    if (count_itr != propcounts.end()) {
+        propcounts.modify(count_itr, same_payer, [&](auto& col) {
+            col.current_count = scan.proposals;
+            col.total_count = std::max(col.total_count, scan.proposals);
+        });
+        log_change(name("propcounts"), get_self().value, proposer.value, change_op::modify);
+    } else if (scan.proposals > 0) {
+        propcounts.emplace(get_self(), [&](auto& col) {
+            col.proposer = proposer;
+            col.current_count = scan.proposals;
+            col.total_count = scan.proposals;
+        });
+        log_change(name("propcounts"), get_self().value, proposer.value, change_op::insert);
+    }
+    print("recompcount: complete, ", scan.proposals, " proposals");
+}
+
+ACTION waxlabs::migprofiles(name lower_bound, uint32_t count)
+{
+    //authenticate
+    require_auth(get_self());
+
+    //open tables
+    profiles_table profiles(get_self(), get_self().value);
+    profileregs_table profileregs(get_self(), get_self().value);
+
+    //validate
+    check(count > 0, "count must be greater than zero");
+
+    //register up to count profiles without a registry row, registered ones don't count
+    bool done_something = false;
+    auto prof_itr = profiles.lower_bound(lower_bound.value);
+    while (prof_itr != profiles.end() && count > 0) {
+        if (profileregs.find(prof_itr->wax_account.value) == profileregs.end()) {
+            //ram payer: contract
+            profileregs.emplace(get_self(), [&](auto& col) {
+                col.wax_account = prof_itr->wax_account;
+                col.registered_ts = time_point_sec(current_time_point());
+                col.draft_slots = 0;
+            });
+            log_change(name("profileregs"), get_self().value, prof_itr->wax_account.value, change_op::insert);
+            done_something = true;
+            count -= 1;
+        }
+        prof_itr++;
+    }
+
+    //only a call that reached the end of the table can have registered nothing
+    check(done_something, "nothing left to register");
+
+    if (prof_itr == profiles.end()) {
+        print("migprofiles: complete");
+    } else {
+        print("migprofiles: continue at ", prof_itr->wax_account);
+    }
 }
 
 //======================== proposal actions ========================
 
-ACTION waxlabs::draftprop(string title, string description, string mdbody, name proposer,
-    string image_url, uint32_t estimated_time, name category, string road_map)
+waxlabs::proposal_result waxlabs::draftprop(WAXLABS_PARAMS(WAXLABS_DRAFTPROP_PARAMS))
 {
     //authenticate
     require_auth(proposer);
 
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
-    //open profiles table, get profile
-    profiles_table profiles(get_self(), get_self().value);
-    auto& prof = profiles.get(proposer.value, "profile not found");
+    //open profileregs table, validate profile
+    profileregs_table profileregs(get_self(), get_self().value);
+    auto& reg = profileregs.get(proposer.value, "profile not found");
 
     //initialize
     auto cat_itr = std::find(conf.categories.begin(), conf.categories.end(), category);
@@ -157,9 +375,18 @@ ACTION waxlabs::draftprop(string title, string description, string mdbody, name
     check(estimated_time > 0, "estimated time must be greater than zero");
     check(road_map.length() <= MAX_ROAD_MAP_LEN, "road map is too long");
 
-    //subtract DRAFT_COST from account balance
-    sub_balance(proposer, DRAFT_COST);
-    conf.available_funds += DRAFT_COST;
+    //use a prepaid draft slot, its DRAFT_COST went to available funds with the transfer.
+    //otherwise pay DRAFT_COST from account balance
+    if (reg.draft_slots > 0) {
+        profileregs.modify(reg, same_payer, [&](auto& col) {
+            col.draft_slots -= 1;
+        });
+        log_change(name("profileregs"), get_self().value, proposer.value, change_op::modify);
+    } else {
+        sub_balance(proposer, DRAFT_COST, name("draftfee"));
+        conf.available_funds += DRAFT_COST;
+        flow_today().funded += DRAFT_COST;
+    }
 
     size_t cat_pos = std::distance(conf.categories.begin(), cat_itr);
 
@@ -173,14 +400,14 @@ ACTION waxlabs::draftprop(string title, string description, string mdbody, name
 
     // update last_proposal_id
     conf.last_proposal_id = new_proposal_id;
-    configs.set(conf, get_self());
+    save_config();
 
     //Increment stats for drafting proposals
-    inc_stats_count(static_cast<uint64_t>(proposal_status::drafting), "Proposals in drafting");
+    inc_stats_count(static_cast<uint64_t>(proposal_status::drafting), proposal_status_name(proposal_status::drafting));
 
     //create new proposal
     //ram payer: proposer
-    proposals.emplace(proposer, [&](auto& col) {
+    auto prop_itr = proposals.emplace(proposer, [&](auto& col) {
         col.proposal_id = new_proposal_id;
         col.proposer = proposer;
         col.category = cat_pos;
@@ -193,20 +420,43 @@ ACTION waxlabs::draftprop(string title, string description, string mdbody, name
         col.update_ts = time_point_sec(current_time_point());
         col.road_map = road_map;
     });
+    log_change(name("proposals"), get_self().value, new_proposal_id, change_op::insert);
+    add_funding(*prop_itr);
+
+    //count proposal for proposer
+    //ram payer: proposer
+    propcounts_table propcounts(get_self(), get_self().value);
+    auto count_itr = propcounts.find(proposer.value);
+    if (count_itr == propcounts.end()) {
+        propcounts.emplace(proposer, [&](auto& col) {
+            col.proposer = proposer;
+            col.current_count = 1;
+            col.total_count = 1;
+        });
+        log_change(name("propcounts"), get_self().value, proposer.value, change_op::insert);
+    } else {
+        propcounts.modify(count_itr, same_payer, [&](auto& col) {
+            col.current_count += 1;
+            col.total_count += 1;
+        });
+        log_change(name("propcounts"), get_self().value, proposer.value, change_op::modify);
+    }
 
     mdbodies.emplace(proposer, [&](auto& col) {
         col.proposal_id = new_proposal_id;
         col.content = mdbody;
     });
+    log_change(name("mdbodies"), get_self().value, new_proposal_id, change_op::insert);
+
+    log_proposal_event(new_proposal_id, proposer, 0, static_cast<uint8_t>(proposal_status::drafting));
+
+    return make_proposal_result(*prop_itr);
 }
 
-ACTION waxlabs::editprop(uint64_t proposal_id, optional<string> title,
-    optional<string> description, optional<string> mdbody, optional<name> category,
-    string image_url, uint32_t estimated_time, optional<string> road_map)
+waxlabs::proposal_result waxlabs::editprop(WAXLABS_PARAMS(WAXLABS_EDITPROP_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //open tables, get proposal and body
     proposals_table proposals(get_self(), get_self().value);
@@ -233,10 +483,10 @@ ACTION waxlabs::editprop(uint64_t proposal_id, optional<string> title,
         check(new_desc.length() <= MAX_DESCR_LEN, "description string is too long");
     }
 
-    string new_mdbody = body.content;
-    if (mdbody) {
-        new_mdbody = *mdbody;
-        check(new_mdbody.length() <= MAX_BODY_LEN, "body string is too long");
+    //only rewrite body if it changed
+    bool body_changed = mdbody && *mdbody != body.content;
+    if (body_changed) {
+        check(mdbody->length() <= MAX_BODY_LEN, "body string is too long");
     }
 
     uint8_t new_category = prop.category;
@@ -255,6 +505,12 @@ ACTION waxlabs::editprop(uint64_t proposal_id, optional<string> title,
         check(new_road_map.length() <= MAX_ROAD_MAP_LEN, "Road map is too long");
     }
 
+    //move funding aggregate only if category changed
+    bool category_changed = new_category != prop.category;
+    if (category_changed) {
+        sub_funding(prop);
+    }
+
     //update proposal
     proposals.modify(prop, same_payer, [&](auto& col) {
         col.category = new_category;
@@ -265,16 +521,24 @@ ACTION waxlabs::editprop(uint64_t proposal_id, optional<string> title,
         col.update_ts = time_point_sec(current_time_point());
         col.road_map = new_road_map;
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    if (category_changed) {
+        add_funding(prop);
+    }
 
-    mdbodies.modify(body, same_payer, [&](auto& col) {
-        col.content = new_mdbody;
-    });
+    if (body_changed) {
+        mdbodies.modify(body, same_payer, [&](auto& col) {
+            col.content = std::move(*mdbody);
+        });
+        log_change(name("mdbodies"), get_self().value, proposal_id, change_op::modify);
+    }
+
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::submitprop(uint64_t proposal_id)
+waxlabs::proposal_result waxlabs::submitprop(WAXLABS_PARAMS(WAXLABS_SUBMITPROP_PARAMS))
 {
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    auto& conf = get_config();
 
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -284,29 +548,30 @@ ACTION waxlabs::submitprop(uint64_t proposal_id)
     require_auth(prop.proposer);
 
     //validate
-    check(prop.status == proposal_status::drafting, "proposal must be in drafting state to submit");
     check(prop.deliverables >= 1, "proposal must have at least one deliverable to submit");
     check(prop.total_requested_funds >= conf.min_requested, "requested amount is less than minimum requested amount");
     check(prop.total_requested_funds <= conf.max_requested, "total requested is more than maximum allowed");
 
-    //decrement current status
-    dec_stats_count(static_cast<uint64_t>(prop.status));
-    //Increment stats for submitted proposals
-    inc_stats_count(static_cast<uint64_t>(proposal_status::submitted), "Proposals in review");
+    //validate and move status stats
+    uint8_t new_status = advance_proposal<proposal_status::submitted, proposal_status::drafting>(
+        prop, "proposal must be in drafting state to submit");
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
-        col.status = static_cast<uint8_t>(proposal_status::submitted);
+        col.status = new_status;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
 
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::reviewprop(uint64_t proposal_id, bool approve, string memo)
+waxlabs::proposal_result waxlabs::reviewprop(WAXLABS_PARAMS(WAXLABS_REVIEWPROP_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -315,39 +580,78 @@ ACTION waxlabs::reviewprop(uint64_t proposal_id, bool approve, string memo)
     proposals_table proposals(get_self(), get_self().value);
     auto& prop = proposals.get(proposal_id, "proposal not found");
 
+    return review_proposal(proposals, prop, approve, memo);
+}
+
+vector<waxlabs::proposal_result> waxlabs::reviewprops(WAXLABS_PARAMS(WAXLABS_REVIEWPROPS_PARAMS))
+{
+    //get config
+    auto& conf = get_config();
+
+    //authenticate
+    require_auth(conf.admin_acct);
+
     //validate
-    check(prop.status == proposal_status::submitted, "proposal must be in submitted state to review");
+    check(reviews.size() > 0 && reviews.size() <= MAX_REVIEW_BATCH, "batch must hold between 1 and " + to_string(MAX_REVIEW_BATCH) + " reviews");
+
+    //open proposals table
+    proposals_table proposals(get_self(), get_self().value);
+
+    //check funding of all skipped votes at once
+    asset skipped_funds = asset(0, WAX_SYM);
+    for (const auto& review : reviews) {
+        check(review.decision == name("approve") || review.decision == name("reject") || review.decision == name("skipvoting"),
+            "decision must be approve, reject or skipvoting");
+        if (review.decision == name("skipvoting")) {
+            skipped_funds += proposals.get(review.proposal_id, "proposal not found").total_requested_funds;
+        }
+    }
+    check(conf.available_funds >= skipped_funds, "WAX Labs has insufficient available funds");
+
+    //apply reviews, config and stats are written once on flush
+    vector<proposal_result> results;
+    for (const auto& review : reviews) {
+        auto& prop = proposals.get(review.proposal_id, "proposal not found");
+        if (review.decision == name("skipvoting")) {
+            results.push_back(skip_voting(proposals, prop));
+        } else {
+            results.push_back(review_proposal(proposals, prop, review.decision == name("approve"), review.memo));
+        }
+    }
 
-    //decrement current status
-    dec_stats_count(static_cast<uint64_t>(proposal_status::submitted));
+    return results;
+}
 
-    set_pcomment(proposal_id, memo, conf.admin_acct);
+waxlabs::proposal_result waxlabs::review_proposal(proposals_table& proposals, const proposal& prop, bool approve, const string& memo)
+{
+    //validate and move status stats
+    const char* error_msg = "proposal must be in submitted state to review";
+    uint8_t new_status;
 
     //if admin approved
     if (approve) {
         //check if reviewer is set
         check(is_account(prop.reviewer), "reviewer account needs to be set before approving");
-        //update proposal to approved
-        proposals.modify(prop, same_payer, [&](auto& col) {
-            col.status = static_cast<uint8_t>(proposal_status::approved);
-            col.update_ts = time_point_sec(current_time_point());
-        });
-
-        //Increment stats for approved proposals
-        inc_stats_count(static_cast<uint64_t>(proposal_status::approved), "Proposals approved");
+        new_status = advance_proposal<proposal_status::approved, proposal_status::submitted>(prop, error_msg);
     } else {
-        //update proposal to failed
-        proposals.modify(prop, same_payer, [&](auto& col) {
-            col.status = static_cast<uint8_t>(proposal_status::failed);
-            col.update_ts = time_point_sec(current_time_point());
-        });
-
-        //Increment stats for failed proposals
-        inc_stats_count(static_cast<uint64_t>(proposal_status::failed), "Proposals failed");
+        new_status = advance_proposal<proposal_status::failed, proposal_status::submitted>(prop, error_msg);
     }
+
+    set_pcomment(prop.proposal_id, memo, get_config().admin_acct);
+
+    //update proposal
+    sub_funding(prop);
+    proposals.modify(prop, same_payer, [&](auto& col) {
+        col.status = new_status;
+        col.update_ts = time_point_sec(current_time_point());
+    });
+    log_change(name("proposals"), get_self().value, prop.proposal_id, change_op::modify);
+    add_funding(prop);
+
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::beginvoting(uint64_t proposal_id, name ballot_name)
+waxlabs::proposal_result waxlabs::beginvoting(WAXLABS_PARAMS(WAXLABS_BEGINVOTING_PARAMS))
 {
     //open tables, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -358,9 +662,8 @@ ACTION waxlabs::beginvoting(uint64_t proposal_id, name ballot_name)
     //authenticate
     require_auth(prop.proposer);
 
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //initialize
     asset newballot_fee = asset(1000000000, WAX_SYM); //10 WAX  TODO: get from decide config table
@@ -369,29 +672,31 @@ ACTION waxlabs::beginvoting(uint64_t proposal_id, name ballot_name)
     vector<name> ballot_options = { name("yes"), name("no") };
 
     //charge proposal fee and newballot_fee
-    sub_balance(prop.proposer, newballot_fee);
+    sub_balance(prop.proposer, newballot_fee, name("ballotfee"));
 
     //validate
-    check(prop.status == proposal_status::approved, "proposal must be approved by admin to begin voting");
     check(conf.deposited_funds >= newballot_fee, "not enough deposited funds");
 
-    //dec and inc stats_counts
-    dec_stats_count(static_cast<uint64_t>(proposal_status::approved));
-    inc_stats_count(static_cast<uint64_t>(proposal_status::voting), "Proposals in voting");
+    //validate and move status stats
+    uint8_t new_status = advance_proposal<proposal_status::voting, proposal_status::approved>(
+        prop, "proposal must be approved by admin to begin voting");
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
-        col.status = static_cast<uint8_t>(proposal_status::voting);
+        col.status = new_status;
         col.ballot_name = ballot_name;
         col.update_ts = time_point_sec(current_time_point());
         col.vote_end_time = ballot_end_time;
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
 
     set_pcomment(proposal_id, "", prop.proposer);
 
     //update and set config
     conf.deposited_funds -= newballot_fee;
-    configs.set(conf, get_self());
+    save_config();
 
     //send inline transfer to pay for newballot fee
     action(permission_level{get_self(), name("active")}, name("eosio.token"), name("transfer"), make_tuple(
@@ -430,13 +735,14 @@ ACTION waxlabs::beginvoting(uint64_t proposal_id, name ballot_name)
         ballot_name, //ballot_name
         ballot_end_time //end_time
     )).send();
+
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::endvoting(uint64_t proposal_id)
+waxlabs::proposal_result waxlabs::endvoting(WAXLABS_PARAMS(WAXLABS_ENDVOTING_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -456,13 +762,13 @@ ACTION waxlabs::endvoting(uint64_t proposal_id)
 
     //NOTE: results processed in catch_broadcast()
 
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::setreviewer(uint64_t proposal_id, uint64_t deliverable_id, name new_reviewer)
+waxlabs::proposal_result waxlabs::setreviewer(WAXLABS_PARAMS(WAXLABS_SETREVIEWER_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //authenticate
     require_auth(conf.admin_acct);
@@ -479,13 +785,15 @@ ACTION waxlabs::setreviewer(uint64_t proposal_id, uint64_t deliverable_id, name
         col.reviewer = new_reviewer;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::cancelprop(uint64_t proposal_id, string memo)
+waxlabs::proposal_result waxlabs::cancelprop(WAXLABS_PARAMS(WAXLABS_CANCELPROP_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -506,31 +814,34 @@ ACTION waxlabs::cancelprop(uint64_t proposal_id, string memo)
     //initialzie
     proposal_status initial_status = static_cast<proposal_status>(prop.status);
 
-    //validate
-    check(prop.status == proposal_status::drafting || prop.status == proposal_status::submitted ||
-          prop.status == proposal_status::approved || prop.status == proposal_status::voting,
-          "proposal must be in drafting, submitted, approved, or voting stages to cancel");
-
-    //inc cancelled / dec current stats
-    dec_stats_count(static_cast<uint64_t>(prop.status));
-    inc_stats_count(static_cast<uint64_t>(proposal_status::cancelled), "Proposals cancelled");
+    //validate and move status stats
+    uint8_t new_status = advance_proposal<proposal_status::cancelled,
+        proposal_status::drafting, proposal_status::submitted, proposal_status::approved, proposal_status::voting>(
+        prop, "proposal must be in drafting, submitted, approved, or voting stages to cancel");
 
     //update proposal.
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
-        col.status = static_cast<uint8_t>(proposal_status::cancelled);
+        col.status = new_status;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
 
     set_pcomment(proposal_id, memo, payer);
 
     //reject all deliverables
     deliverables_table deliverables(get_self(), proposal_id);
+    dcomments_table dcomments(get_self(), proposal_id);
     auto deliv_iter = deliverables.begin();
     while( deliv_iter != deliverables.end() ) {
+        uint8_t new_deliv_status = advance_deliverable<deliverable_status::rejected, deliverable_status::drafting>(
+            *deliv_iter, "deliverable must be in drafting state to cancel");
         deliverables.modify(*deliv_iter, _self, [&](auto& col) {
-            col.status = static_cast<uint8_t>(deliverable_status::rejected);
+            col.status = new_deliv_status;
         });
-        set_dcomment(proposal_id, deliv_iter->deliverable_id, memo, payer);
+        log_change(name("deliverables"), proposal_id, deliv_iter->deliverable_id, change_op::modify);
+        set_dcomment(dcomments, deliv_iter->deliverable_id, memo, payer);
         deliv_iter++;
     }
 
@@ -542,13 +853,14 @@ ACTION waxlabs::cancelprop(uint64_t proposal_id, string memo)
             string("WAX Labs Proposal Cancellation") //memo
         )).send();
     }
+
+    return make_proposal_result(prop);
 }
 
-ACTION waxlabs::deleteprop(uint64_t proposal_id)
+waxlabs::proposal_result waxlabs::deleteprop(WAXLABS_PARAMS(WAXLABS_DELETEPROP_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -574,22 +886,53 @@ ACTION waxlabs::deleteprop(uint64_t proposal_id)
         conf.available_funds += prop.remaining_funds;
 
         //update config
-        configs.set(conf, get_self());
+        save_config();
     }
 
     set_pcomment(proposal_id, "", _self); //release comment RAM
 
     //erase each deliverable
     deliverables_table deliverables(get_self(), proposal_id);
+    dcomments_table dcomments(get_self(), proposal_id);
     auto deliv_iter = deliverables.begin();
     while( deliv_iter != deliverables.end() ) {
-        set_dcomment(proposal_id, deliv_iter->deliverable_id, "", _self); //release comment RAM
+        set_dcomment(dcomments, deliv_iter->deliverable_id, "", _self); //release comment RAM
+        log_change(name("deliverables"), proposal_id, deliv_iter->deliverable_id, change_op::erase);
         deliv_iter = deliverables.erase(deliv_iter);
     }
+    rmv_dreviewers(proposal_id); //release reviewer RAM
+
+    //initialize result before the rows are gone
+    proposal_result result = make_proposal_result(prop);
+
+    //uncount proposal
+    sub_funding(prop);
+    propcounts_table propcounts(get_self(), get_self().value);
+    auto count_itr = propcounts.find(prop.proposer.value);
+    if (count_itr != propcounts.end() && count_itr->current_count > 0) {
+        propcounts.modify(count_itr, same_payer, [&](auto& col) {
+            col.current_count -= 1;
+        });
+        log_change(name("propcounts"), get_self().value, prop.proposer.value, change_op::modify);
+    }
+
+    //a recompcount scan in progress has already counted proposals below its cursor
+    countscans_table countscans(get_self(), get_self().value);
+    auto scan_itr = countscans.find(prop.proposer.value);
+    if (scan_itr != countscans.end() && proposal_id < scan_itr->next_id && scan_itr->proposals > 0) {
+        countscans.modify(scan_itr, same_payer, [&](auto& col) {
+            col.proposals -= 1;
+        });
+        log_change(name("countscans"), get_self().value, prop.proposer.value, change_op::modify);
+    }
 
     //erase proposal
     proposals.erase(prop);
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::erase);
     mdbodies.erase(body);
+    log_change(name("mdbodies"), get_self().value, proposal_id, change_op::erase);
+
+    return result;
 }
 
 
@@ -598,11 +941,10 @@ ACTION waxlabs::deleteprop(uint64_t proposal_id)
 
 //======================== deliverable actions ========================
 
-ACTION waxlabs::newdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset requested_amount, name recipient, string small_description, uint32_t days_to_complete)
+waxlabs::deliverable_result waxlabs::newdeliv(WAXLABS_PARAMS(WAXLABS_NEWDELIV_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -622,23 +964,29 @@ ACTION waxlabs::newdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset re
     //add new deliverable
     //ram payer: proposer
     deliverables_table deliverables(get_self(), proposal_id);
-    deliverables.emplace(prop.proposer, [&](auto& col) {
+    auto deliv_itr = deliverables.emplace(prop.proposer, [&](auto& col) {
         col.deliverable_id = deliverable_id;
         col.requested = requested_amount;
         col.recipient = recipient;
         col.small_description = small_description;
         col.days_to_complete = days_to_complete;
     });
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::insert);
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
         col.total_requested_funds += requested_amount;
         col.deliverables += 1;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
+
+    return make_deliverable_result(prop, *deliv_itr);
 }
 
-ACTION waxlabs::rmvdeliv(uint64_t proposal_id, uint64_t deliverable_id)
+waxlabs::deliverable_result waxlabs::rmvdeliv(WAXLABS_PARAMS(WAXLABS_RMVDELIV_PARAMS))
 {
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -656,18 +1004,36 @@ ACTION waxlabs::rmvdeliv(uint64_t proposal_id, uint64_t deliverable_id)
     check(prop.total_requested_funds - deliv.requested >= asset(0, WAX_SYM), "total requested amount cannot be below zero");
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
         col.total_requested_funds -= deliv.requested;
         col.deliverables -= 1;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
 
     set_dcomment(proposal_id, deliverable_id, "", _self); //release comment RAM
+
+    //release reviewer RAM
+    dreviewers_table dreviewers(get_self(), get_self().value);
+    auto drev_itr = dreviewers.find(waxlabs_keys::deliverable(proposal_id, deliverable_id));
+    if (drev_itr != dreviewers.end() && drev_itr->deliverable_id == deliverable_id) {
+        log_change(name("dreviewers"), get_self().value, drev_itr->primary_key(), change_op::erase);
+        dreviewers.erase(drev_itr);
+    }
+
+    //initialize result before the row is gone
+    deliverable_result result = make_deliverable_result(prop, deliv);
+
     //erase deliverable
     deliverables.erase(deliv);
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::erase);
+
+    return result;
 }
 
-ACTION waxlabs::editdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset new_requested_amount, name new_recipient, string small_description, uint32_t days_to_complete)
+waxlabs::deliverable_result waxlabs::editdeliv(WAXLABS_PARAMS(WAXLABS_EDITDELIV_PARAMS))
 {
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -680,9 +1046,8 @@ ACTION waxlabs::editdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset n
     deliverables_table deliverables(get_self(), proposal_id);
     auto& deliv = deliverables.get(deliverable_id, "deliverable not found");
 
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //initialize
     asset request_delta = new_requested_amount - deliv.requested;
@@ -704,15 +1069,21 @@ ACTION waxlabs::editdeliv(uint64_t proposal_id, uint64_t deliverable_id, asset n
         col.small_description = small_description;
         col.days_to_complete = days_to_complete;
     });
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::modify);
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
         col.total_requested_funds = new_total_requested;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
+
+    return make_deliverable_result(prop, deliv);
 }
 
-ACTION waxlabs::submitreport(uint64_t proposal_id, uint64_t deliverable_id, string report)
+waxlabs::deliverable_result waxlabs::submitreport(WAXLABS_PARAMS(WAXLABS_SUBMITREPORT_PARAMS))
 {
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -727,26 +1098,33 @@ ACTION waxlabs::submitreport(uint64_t proposal_id, uint64_t deliverable_id, stri
 
     //validate
     check(prop.status == proposal_status::inprogress, "must submit report when proposal is in progress");
-    check(deliv.status == deliverable_status::inprogress || deliv.status == deliverable_status::rejected,
-        "deliverable must be in progress or rejected to submit/resubmit report");
+    uint8_t new_deliv_status = advance_deliverable<deliverable_status::reported,
+        deliverable_status::inprogress, deliverable_status::rejected>(
+        deliv, "deliverable must be in progress or rejected to submit/resubmit report");
     check(report != "", "report cannot be empty");
 
+    log_deliverable_event(proposal_id, deliv, new_deliv_status);
+
     //update deliverable
     deliverables.modify(deliv, same_payer, [&](auto& col) {
-        col.status = static_cast<uint8_t>(deliverable_status::reported);
+        col.status = new_deliv_status;
         col.report = report;
     });
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::modify);
     set_dcomment(proposal_id, deliverable_id, "", prop.proposer);
+
+    return make_deliverable_result(prop, deliv);
 }
 
-ACTION waxlabs::reviewdeliv(uint64_t proposal_id, uint64_t deliverable_id, bool accept, string memo)
+waxlabs::deliverable_result waxlabs::reviewdeliv(WAXLABS_PARAMS(WAXLABS_REVIEWDELIV_PARAMS))
 {
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
     auto& prop = proposals.get(proposal_id, "proposal not found");
 
     //authenticate
-    require_auth(prop.reviewer);
+    name reviewer = get_dreviewer(prop, deliverable_id);
+    require_auth(reviewer);
 
     //open deliverables table, get deliverable
     deliverables_table deliverables(get_self(), proposal_id);
@@ -754,27 +1132,27 @@ ACTION waxlabs::reviewdeliv(uint64_t proposal_id, uint64_t deliverable_id, bool
 
     //validate
     check(prop.status == proposal_status::inprogress, "proposal must be in progress to review deliverable");
-    check(deliv.status == deliverable_status::reported, "deliverable must be reported to review");
-
-    //if accepted
-    if (accept) {
-        //update deliverable
-        deliverables.modify(deliv, same_payer, [&](auto& col) {
-            col.status = static_cast<uint8_t>(deliverable_status::accepted);
-            col.review_time = time_point_sec(current_time_point());
-        });
-    } else {
-        //update deliverable
-        deliverables.modify(deliv, same_payer, [&](auto& col) {
-            col.status = static_cast<uint8_t>(deliverable_status::rejected);
-            col.review_time = time_point_sec(current_time_point());
-        });
-    }
+    const char* error_msg = "deliverable must be reported to review";
+    uint8_t new_deliv_status = accept ?
+        advance_deliverable<deliverable_status::accepted, deliverable_status::reported>(deliv, error_msg) :
+        advance_deliverable<deliverable_status::rejected, deliverable_status::reported>(deliv, error_msg);
+
+    log_deliverable_event(proposal_id, deliv, new_deliv_status);
 
-    set_dcomment(proposal_id, deliverable_id, memo, prop.reviewer);
+    //update deliverable
+    deliverables.modify(deliv, same_payer, [&](auto& col) {
+        col.status = new_deliv_status;
+        col.review_time = time_point_sec(current_time_point());
+    });
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::modify);
+
+    //ram payer: the reviewer that signed
+    set_dcomment(proposal_id, deliverable_id, memo, reviewer);
+
+    return make_deliverable_result(prop, deliv);
 }
 
-ACTION waxlabs::claimfunds(uint64_t proposal_id, uint64_t deliverable_id)
+waxlabs::deliverable_result waxlabs::claimfunds(WAXLABS_PARAMS(WAXLABS_CLAIMFUNDS_PARAMS))
 {
     //open proposals table, get proposal
     proposals_table proposals(get_self(), get_self().value);
@@ -787,18 +1165,21 @@ ACTION waxlabs::claimfunds(uint64_t proposal_id, uint64_t deliverable_id)
     //authenticate
     check(has_auth(prop.proposer) || has_auth(deliv.recipient), "claiming funds requires authentication from proposer or recipient");
 
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
     //validate
     check(prop.status == proposal_status::inprogress, "proposal must be in progress to claim funds");
-    check(deliv.status == deliverable_status::accepted, "deliverable must be accepted by reviewer to claim funds");
+    uint8_t new_deliv_status = advance_deliverable<deliverable_status::claimed, deliverable_status::accepted>(
+        deliv, "deliverable must be accepted by reviewer to claim funds");
+
+    log_deliverable_event(proposal_id, deliv, new_deliv_status);
 
     //update deliverable
     deliverables.modify(deliv, same_payer, [&](auto& col) {
-        col.status = static_cast<uint8_t>(deliverable_status::claimed);
+        col.status = new_deliv_status;
     });
+    log_change(name("deliverables"), proposal_id, deliverable_id, change_op::modify);
     set_dcomment(proposal_id, deliverable_id, "", _self); //it's releasing RAM, no need for payer
 
     //initialize
@@ -806,45 +1187,110 @@ ACTION waxlabs::claimfunds(uint64_t proposal_id, uint64_t deliverable_id)
 
     //if last deliverable
     if (prop.deliverables_completed == (prop.deliverables - 1)) {
-        new_prop_status = static_cast<uint8_t>(proposal_status::completed);
-        dec_stats_count(static_cast<uint64_t>(proposal_status::inprogress));
-        inc_stats_count(static_cast<uint64_t>(proposal_status::completed), "Completed Proposals");
+        new_prop_status = advance_proposal<proposal_status::completed, proposal_status::inprogress>(
+            prop, "proposal must be in progress to claim funds");
     }
 
     //update proposal
+    sub_funding(prop);
     proposals.modify(prop, same_payer, [&](auto& col) {
         col.status = new_prop_status;
         col.remaining_funds -= deliv.requested;
         col.deliverables_completed += 1;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, proposal_id, change_op::modify);
+    add_funding(prop);
 
     //update and set conf
     conf.reserved_funds -= deliv.requested;
     conf.paid_funds += deliv.requested;
-    configs.set(conf, get_self());
+    save_config();
+    flow_today().claimed += deliv.requested;
 
     //move requested funds to recipient account
-    add_balance(deliv.recipient, deliv.requested);
+    add_balance(deliv.recipient, deliv.requested, name("claim"));
+
+    return make_deliverable_result(prop, deliv);
+}
+
+waxlabs::deliverable_result waxlabs::setdreviewer(WAXLABS_PARAMS(WAXLABS_SETDREVIEWER_PARAMS))
+{
+    //get config
+    auto& conf = get_config();
+
+    //authenticate
+    require_auth(conf.admin_acct);
+
+    //open tables, get proposal and deliverable
+    proposals_table proposals(get_self(), get_self().value);
+    auto& prop = proposals.get(proposal_id, "proposal not found");
+    deliverables_table deliverables(get_self(), proposal_id);
+    auto& deliv = deliverables.get(deliverable_id, "deliverable not found");
+
+    //validate
+    check(deliverable_id <= 0xFFFFFFFF, "deliverable id too large for a deliverable reviewer");
+    check(new_reviewer == name(0) || is_account(new_reviewer), "new reviewer account doesn't exist");
+    check((status_mask<deliverable_status, deliverable_status::drafting, deliverable_status::inprogress,
+        deliverable_status::reported, deliverable_status::rejected>() >> deliv.status) & 1,
+        "deliverable has already been accepted");
+
+    //open dreviewers table, find deliverable reviewer
+    dreviewers_table dreviewers(get_self(), get_self().value);
+    uint64_t key = waxlabs_keys::deliverable(proposal_id, deliverable_id);
+    auto drev_itr = dreviewers.find(key);
+
+    if (new_reviewer == name(0)) {
+        //fall back to proposal reviewer
+        if (drev_itr != dreviewers.end()) {
+            dreviewers.erase(drev_itr);
+            log_change(name("dreviewers"), get_self().value, key, change_op::erase);
+        }
+    } else if (drev_itr == dreviewers.end()) {
+        //ram payer: self
+        dreviewers.emplace(get_self(), [&](auto& col) {
+            col.proposal_id = proposal_id;
+            col.deliverable_id = deliverable_id;
+            col.reviewer = new_reviewer;
+        });
+        log_change(name("dreviewers"), get_self().value, key, change_op::insert);
+    } else {
+        dreviewers.modify(drev_itr, same_payer, [&](auto& col) {
+            col.reviewer = new_reviewer;
+        });
+        log_change(name("dreviewers"), get_self().value, key, change_op::modify);
+    }
+
+    return make_deliverable_result(prop, deliv);
 }
 
 //======================== profile actions ========================
 
-ACTION waxlabs::newprofile(name wax_account, string full_name, string country, string bio,
-    string image_url, string website, string contact, string group_name)
+ACTION waxlabs::newprofile(WAXLABS_PARAMS(WAXLABS_PROFILE_PARAMS))
 {
     //authenticate
     require_auth(wax_account);
 
-    //open profiles table, find profile
-    profiles_table profiles(get_self(), get_self().value);
-    auto prof_itr = profiles.find(wax_account.value);
+    //open profileregs table, find profile
+    profileregs_table profileregs(get_self(), get_self().value);
+    auto reg_itr = profileregs.find(wax_account.value);
 
     //validate
-    check(prof_itr == profiles.end(), "profile already exists");
+    check(reg_itr == profileregs.end(), "profile already exists");
+    check_profile_strings(full_name, country, bio, image_url, website, contact, group_name);
+
+    //register profile
+    //ram payer: profile owner
+    profileregs.emplace(wax_account, [&](auto& col) {
+        col.wax_account = wax_account;
+        col.registered_ts = time_point_sec(current_time_point());
+        col.draft_slots = 0;
+    });
+    log_change(name("profileregs"), get_self().value, wax_account.value, change_op::insert);
 
     //create new profile
     //ram payer: profile owner
+    profiles_table profiles(get_self(), get_self().value);
     profiles.emplace(wax_account, [&](auto& col) {
         col.wax_account = wax_account;
         col.full_name = full_name;
@@ -855,10 +1301,10 @@ ACTION waxlabs::newprofile(name wax_account, string full_name, string country, s
         col.contact = contact;
         col.group_name = group_name;
     });
+    log_change(name("profiles"), get_self().value, wax_account.value, change_op::insert);
 }
 
-ACTION waxlabs::editprofile(name wax_account, string full_name, string country, string bio,
-    string image_url, string website, string contact, string group_name)
+ACTION waxlabs::editprofile(WAXLABS_PARAMS(WAXLABS_PROFILE_PARAMS))
 {
     //authenticate
     require_auth(wax_account);
@@ -867,6 +1313,9 @@ ACTION waxlabs::editprofile(name wax_account, string full_name, string country,
     profiles_table profiles(get_self(), get_self().value);
     auto& prof = profiles.get(wax_account.value, "profile not found");
 
+    //validate
+    check_profile_strings(full_name, country, bio, image_url, website, contact, group_name);
+
     //update profile
     profiles.modify(prof, same_payer, [&](auto& col) {
         col.full_name = full_name;
@@ -877,55 +1326,155 @@ ACTION waxlabs::editprofile(name wax_account, string full_name, string country,
         col.contact = contact;
         col.group_name = group_name;
     });
+    log_change(name("profiles"), get_self().value, wax_account.value, change_op::modify);
 }
 
-ACTION waxlabs::rmvprofile(name wax_account)
+ACTION waxlabs::rmvprofile(WAXLABS_PARAMS(WAXLABS_RMVPROFILE_PARAMS))
 {
-    //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+    //get config
+    auto& conf = get_config();
 
-    //open profiles table, find profile
-    profiles_table profiles(get_self(), get_self().value);
-    auto& prof = profiles.get(wax_account.value, "profile not found");
+    //open profileregs table, get profile
+    profileregs_table profileregs(get_self(), get_self().value);
+    auto& reg = profileregs.get(wax_account.value, "profile not found");
 
     //authenticate
-    check(has_auth(prof.wax_account) || has_auth(conf.admin_acct), "requires authentication from profile account or admin account");
+    check(has_auth(reg.wax_account) || has_auth(conf.admin_acct), "requires authentication from profile account or admin account");
 
     //check that there are no proposals by this account
     proposals_table proposals(get_self(), get_self().value);
     auto props_by_proposer = proposals.get_index<name("byproposer")>();
-    auto by_proposer_itr = props_by_proposer.lower_bound((uint128_t)wax_account.value << 64);
+    auto by_proposer_itr = props_by_proposer.lower_bound(waxlabs_keys::account_lower_bound(wax_account.value));
     check(by_proposer_itr == props_by_proposer.end() || by_proposer_itr->proposer != wax_account,
           "there are still active proposals by this account");
 
+    //return unused draft slots
+    if (reg.draft_slots > 0) {
+        refund_draft_slots(wax_account, reg.draft_slots);
+    }
+
     //erase profile
-    profiles.erase(prof);
+    log_change(name("profileregs"), get_self().value, wax_account.value, change_op::erase);
+    profileregs.erase(reg);
+    profiles_table profiles(get_self(), get_self().value);
+    auto prof_itr = profiles.find(wax_account.value);
+    if (prof_itr != profiles.end()) {
+        log_change(name("profiles"), get_self().value, wax_account.value, change_op::erase);
+        profiles.erase(prof_itr);
+    }
 }
 
 //======================== account actions ========================
 
-ACTION waxlabs::withdraw(name account_name, asset quantity)
+waxlabs::balance_result waxlabs::withdraw(WAXLABS_PARAMS(WAXLABS_WITHDRAW_PARAMS))
 {
     //authenticate
-    require_auth(account_name);
+    require_auth(account_owner);
 
     //validate
     check(quantity.symbol == WAX_SYM, "must withdraw WAX");
     check(quantity.amount > 0, "must withdraw positive amount");
 
     //subtract balance from account
-    sub_balance(account_name, quantity);
+    asset new_balance = sub_balance(account_owner, quantity, name("withdraw"));
+    flow_today().withdrawn += quantity;
 
     //inline transfer
     action(permission_level{get_self(), name("active")}, name("eosio.token"), name("transfer"), make_tuple(
         get_self(), //from
-        account_name, //to
+        account_owner, //to
         quantity, //quantity
         std::string("Wax Labs Withdrawal") //memo
     )).send();
+
+    return { account_owner, new_balance };
+}
+
+ACTION waxlabs::refundslots(WAXLABS_PARAMS(WAXLABS_REFUNDSLOTS_PARAMS))
+{
+    //authenticate
+    require_auth(account_owner);
+
+    //open profileregs table, get profile
+    profileregs_table profileregs(get_self(), get_self().value);
+    auto& reg = profileregs.get(account_owner.value, "profile not found");
+
+    //validate
+    check(reg.draft_slots > 0, "no draft slots reserved");
+
+    //initialize
+    uint32_t slots = reg.draft_slots;
+
+    //clear draft slots
+    profileregs.modify(reg, same_payer, [&](auto& col) {
+        col.draft_slots = 0;
+    });
+    log_change(name("profileregs"), get_self().value, account_owner.value, change_op::modify);
+
+    refund_draft_slots(account_owner, slots);
+}
+
+
+//======================== query actions ========================
+
+waxlabs::proposal_view waxlabs::getproposal(uint64_t proposal_id)
+{
+    //open proposals table, get proposal
+    proposals_table proposals(get_self(), get_self().value);
+    auto& prop = proposals.get(proposal_id, "proposal not found");
+
+    return make_proposal_view(prop);
+}
+
+waxlabs::proposal_page waxlabs::getprops(name index_name, uint128_t lower_bound, uint128_t upper_bound, uint32_t limit)
+{
+    //validate
+    check(limit > 0 && limit <= MAX_PAGE_SIZE, "limit must be between 1 and " + to_string(MAX_PAGE_SIZE));
+    check(lower_bound <= upper_bound, "lower bound must not be above upper bound");
+
+    //open proposals table
+    proposals_table proposals(get_self(), get_self().value);
+
+    if (index_name == name("bystatcat")) {
+        return walk_proposals(proposals.get_index<name("bystatcat")>(), lower_bound, upper_bound, limit);
+    } else if (index_name == name("bycatstat")) {
+        return walk_proposals(proposals.get_index<name("bycatstat")>(), lower_bound, upper_bound, limit);
+    } else if (index_name == name("byproposer")) {
+        return walk_proposals(proposals.get_index<name("byproposer")>(), lower_bound, upper_bound, limit);
+    } else if (index_name == name("byupdatets")) {
+        return walk_proposals(proposals.get_index<name("byupdatets")>(), lower_bound, upper_bound, limit);
+    }
+
+    check(false, "index must be bystatcat, bycatstat, byproposer or byupdatets");
+    return {};
 }
 
+//======================== event actions ========================
+
+ACTION waxlabs::logpropstat(uint64_t proposal_id, name proposer, uint8_t old_status, uint8_t new_status)
+{
+    //authenticate
+    require_auth(get_self());
+}
+
+ACTION waxlabs::logdelvstat(uint64_t proposal_id, uint64_t deliverable_id, uint8_t old_status, uint8_t new_status,
+    asset requested, name recipient)
+{
+    //authenticate
+    require_auth(get_self());
+}
+
+ACTION waxlabs::logbalance(name account_owner, asset old_balance, asset new_balance, name reason)
+{
+    //authenticate
+    require_auth(get_self());
+}
+
+ACTION waxlabs::logfunds(name account, asset quantity, asset available_funds, asset deposited_funds, name reason)
+{
+    //authenticate
+    require_auth(get_self());
+}
 
 //======================== notification handlers ========================
 
@@ -941,22 +1490,46 @@ void waxlabs::catch_transfer(name from, name to, asset quantity, string memo)
             return;
         }
 
-        //open config singleton, get config
-        config_singleton configs(get_self(), get_self().value);
-        auto conf = configs.get();
+        //prepays DRAFT_COST per draft slot straight into available funds
+        if (memo == std::string("draft")) {
+            check(quantity.amount > 0 && quantity.amount % DRAFT_COST.amount == 0, "draft transfer must be a multiple of the draft cost");
+            uint32_t new_slots = quantity.amount / DRAFT_COST.amount;
+
+            //count slots on the profile registry row, a same size modify bills no RAM
+            profileregs_table profileregs(get_self(), get_self().value);
+            auto& reg = profileregs.get(from.value, "create a profile before reserving draft slots");
+            profileregs.modify(reg, same_payer, [&](auto& col) {
+                col.draft_slots += new_slots;
+            });
+            log_change(name("profileregs"), get_self().value, from.value, change_op::modify);
+
+            //update config funds
+            auto& conf = get_config();
+            conf.available_funds += quantity;
+            save_config();
+            flow_today().funded += quantity;
+            log_funds_event(from, quantity, name("draft"));
+            return;
+        }
+
+        //get config
+        auto& conf = get_config();
 
         //adds to available funds
         if (memo == std::string("fund")) {
             //update available funds
             conf.available_funds += quantity;
-            configs.set(conf, get_self());
+            save_config();
+            flow_today().funded += quantity;
+            log_funds_event(from, quantity, name("fund"));
         } else {
             //update account balance
-            add_balance(from, quantity);
+            add_balance(from, quantity, name("deposit"));
 
             //update config funds
             conf.deposited_funds += quantity;
-            configs.set(conf, get_self());
+            save_config();
+            flow_today().deposited += quantity;
         }
     }
 }
@@ -979,117 +1552,138 @@ void waxlabs::catch_broadcast(name ballot_name, map<name, asset> final_results,
     //if proposal found
     if (by_ballot_itr != props_by_ballot.end()) {
 
-        //open config singleton, get config
-        config_singleton configs(get_self(), get_self().value);
-        auto conf = configs.get();
+        //get config
+        auto& conf = get_config();
 
         //open wax decide treasury table, get treasury
         treasuries_table treasuries(name("decide"), name("decide").value);
         auto& trs = treasuries.get(VOTE_SYM.code().raw(), "treasury not found");
 
-        //validate
-        check(by_ballot_itr->status == proposal_status::voting, "proposal must be in voting state to end voting");
-
         //initialize
-        proposal_status new_prop_status;
-        asset new_remaining_funds = asset(0, WAX_SYM);
+        const char* error_msg = "proposal must be in voting state to end voting";
         asset total_votes = final_results[name("yes")] + final_results[name("no")];
-        asset quorum_thresh = trs.supply * conf.quorum_threshold / 100;
-        asset approve_thresh = total_votes * conf.yes_threshold / 100;
-
-        dec_stats_count(static_cast<uint64_t>(proposal_status::voting));
 
         //if total votes passed quorum thresh and yes votes passed approve thresh
-        if (total_votes >= quorum_thresh && final_results["yes"_n] > approve_thresh) {
-            //validate
+        if (did_pass_quorum_thresh(total_votes, trs.supply, conf.quorum_threshold_bps) &&
+            did_pass_yes_thresh(final_results[name("yes")], total_votes, conf.yes_threshold_bps)) {
+            //validate and move status stats
+            uint8_t new_prop_status = advance_proposal<proposal_status::inprogress, proposal_status::voting>(
+                *by_ballot_itr, error_msg);
             check(conf.available_funds >= by_ballot_itr->total_requested_funds, "WAX Labs has insufficient available funds");
 
             //update config funds
             conf.available_funds -= by_ballot_itr->total_requested_funds;
             conf.reserved_funds += by_ballot_itr->total_requested_funds;
-            configs.set(conf, get_self());
+            flow_today().reserved += by_ballot_itr->total_requested_funds;
+            save_config();
 
             //loop over all deliverables
             deliverables_table deliverables(get_self(), by_ballot_itr->proposal_id);
             auto deliv_iter = deliverables.begin();
             while( deliv_iter != deliverables.end() ) {
+                uint8_t new_deliv_status = advance_deliverable<deliverable_status::inprogress, deliverable_status::drafting>(
+                    *deliv_iter, "deliverable must be in drafting state to start");
                 deliverables.modify(*deliv_iter, same_payer, [&](auto& col) {
-                    col.status = static_cast<uint8_t>(deliverable_status::inprogress);
+                    col.status = new_deliv_status;
                 });
+                log_change(name("deliverables"), by_ballot_itr->proposal_id, deliv_iter->deliverable_id, change_op::modify);
                 deliv_iter++;
             }
 
             //update proposal; rampayer=self because of inserting the string
+            sub_funding(*by_ballot_itr);
             proposals.modify(*by_ballot_itr, _self, [&](auto& col) {
-                col.status = static_cast<uint8_t>(proposal_status::inprogress);
+                col.status = new_prop_status;
                 col.remaining_funds = by_ballot_itr->total_requested_funds;
                 col.update_ts = time_point_sec(current_time_point());
             });
+            log_change(name("proposals"), get_self().value, by_ballot_itr->proposal_id, change_op::modify);
+            add_funding(*by_ballot_itr);
             // payer=self because it's a notification
             set_pcomment(by_ballot_itr->proposal_id, "voting finished", _self);
-            inc_stats_count(static_cast<uint64_t>(proposal_status::inprogress), "Proposals in progress");
         } else {
+            //validate and move status stats
+            uint8_t new_prop_status = advance_proposal<proposal_status::failed, proposal_status::voting>(
+                *by_ballot_itr, error_msg);
+
             //update proposal; rampayer=self because of inserting the string
+            sub_funding(*by_ballot_itr);
             proposals.modify(*by_ballot_itr, _self, [&](auto& col) {
-                col.status = static_cast<uint8_t>(proposal_status::failed);
+                col.status = new_prop_status;
                 col.update_ts = time_point_sec(current_time_point());
             });
+            log_change(name("proposals"), get_self().value, by_ballot_itr->proposal_id, change_op::modify);
+            add_funding(*by_ballot_itr);
             // payer=self because it's a notification
             set_pcomment(by_ballot_itr->proposal_id, "insufficient votes", _self);
-            inc_stats_count(static_cast<uint64_t>(proposal_status::failed), "Proposals failed");
         }
     }
 }
 
-ACTION waxlabs::skipvoting(uint64_t proposal_id, string memo)
+waxlabs::proposal_result waxlabs::skipvoting(WAXLABS_PARAMS(WAXLABS_SKIPVOTING_PARAMS))
 {
-     //open config singleton, get config
-    config_singleton configs(get_self(), get_self().value);
-    auto conf = configs.get();
+     //get config
+    auto& conf = get_config();
 
     require_auth(conf.admin_acct);
     
     proposals_table proposals(get_self(), get_self().value);
     auto& prop = proposals.get(proposal_id, "proposal not found");
 
-    check(prop.status == proposal_status::submitted, "proposal must be submitted to skip voting.");
-    
-    dec_stats_count(static_cast<uint64_t>(proposal_status::submitted));
+    check(conf.available_funds >= prop.total_requested_funds, "WAX Labs has insufficient available funds");
+
+    return skip_voting(proposals, prop);
+}
+
+waxlabs::proposal_result waxlabs::skip_voting(proposals_table& proposals, const proposal& prop)
+{
+    //get config
+    auto& conf = get_config();
 
     check(is_account(prop.reviewer), "reviewer account needs to be set before skipping vote");
-    check(conf.available_funds >= prop.total_requested_funds, "WAX Labs has insufficient available funds");
+
+    //validate and move status stats
+    uint8_t new_status = advance_proposal<proposal_status::inprogress, proposal_status::submitted>(
+        prop, "proposal must be submitted to skip voting.");
 
     //update config funds
     conf.available_funds -= prop.total_requested_funds;
     conf.reserved_funds += prop.total_requested_funds;
+    flow_today().reserved += prop.total_requested_funds;
 
-    configs.set(conf, get_self());
+    save_config();
 
     //loop over all deliverables
     deliverables_table deliverables(get_self(), prop.proposal_id);
     auto deliv_iter = deliverables.begin();
     while( deliv_iter != deliverables.end() ) {
+        uint8_t new_deliv_status = advance_deliverable<deliverable_status::inprogress, deliverable_status::drafting>(
+            *deliv_iter, "deliverable must be in drafting state to start");
         deliverables.modify(*deliv_iter, same_payer, [&](auto& col) {
-            col.status = static_cast<uint8_t>(deliverable_status::inprogress);
+            col.status = new_deliv_status;
         });
+        log_change(name("deliverables"), prop.proposal_id, deliv_iter->deliverable_id, change_op::modify);
         deliv_iter++;
     }
 
     //update proposal; rampayer=self because of inserting the string
+    sub_funding(prop);
     proposals.modify(prop, _self, [&](auto& col) {
-        col.status = static_cast<uint8_t>(proposal_status::inprogress);
+        col.status = new_status;
         col.remaining_funds = prop.total_requested_funds;
         col.update_ts = time_point_sec(current_time_point());
     });
+    log_change(name("proposals"), get_self().value, prop.proposal_id, change_op::modify);
+    add_funding(prop);
 
     set_pcomment(prop.proposal_id, "Admin skipped voting", _self);
-    inc_stats_count(static_cast<uint64_t>(proposal_status::inprogress), "Proposals in progress");
 
+    return make_proposal_result(prop);
 }
 
 //======================== functions ========================
 
-void waxlabs::sub_balance(name account_owner, asset quantity)
+asset waxlabs::sub_balance(name account_owner, asset quantity, name reason)
 {
     //open accounts table, get account
     accounts_table accounts(get_self(), account_owner.value);
@@ -1098,71 +1692,539 @@ void waxlabs::sub_balance(name account_owner, asset quantity)
     //validate
     check(acct.balance >= quantity, "sub_balance: insufficient funds >>> needed: " + asset(quantity.amount - acct.balance.amount, WAX_SYM).to_string());
 
+    log_balance_event(account_owner, acct.balance, acct.balance - quantity, reason);
+
     if (acct.balance == quantity) {
         //clean up RAM because new balance is zero
         accounts.erase(acct);
-    } else {
-        //subtract quantity from balance
-        accounts.modify(acct, same_payer, [&](auto& col) {
-            col.balance -= quantity;
-        });
+        log_change(name("accounts"), account_owner.value, WAX_SYM.code().raw(), change_op::erase);
+        return asset(0, WAX_SYM);
     }
+
+    //subtract quantity from balance
+    accounts.modify(acct, same_payer, [&](auto& col) {
+        col.balance -= quantity;
+    });
+    log_change(name("accounts"), account_owner.value, WAX_SYM.code().raw(), change_op::modify);
+    return acct.balance;
 }
 
-void waxlabs::add_balance(name account_owner, asset quantity)
+asset waxlabs::add_balance(name account_owner, asset quantity, name reason)
 {
     //open accounts table, get account
     accounts_table accounts(get_self(), account_owner.value);
     auto acct = accounts.find(WAX_SYM.code().raw());
 
     //emplace account if not found, update if exists
+    asset old_balance = acct == accounts.end() ? asset(0, WAX_SYM) : acct->balance;
+    log_balance_event(account_owner, old_balance, old_balance + quantity, reason);
+
     if (acct == accounts.end()) {
         //make new account entry
         accounts.emplace(get_self(), [&](auto& col) {
             col.balance = quantity;
         });
-    } else {
-        //update existing account
-        accounts.modify(*acct, same_payer, [&](auto& col) {
-            col.balance += quantity;
-        });
+        log_change(name("accounts"), account_owner.value, WAX_SYM.code().raw(), change_op::insert);
+        return quantity;
+    }
+
+    //update existing account
+    accounts.modify(*acct, same_payer, [&](auto& col) {
+        col.balance += quantity;
+    });
+    log_change(name("accounts"), account_owner.value, WAX_SYM.code().raw(), change_op::modify);
+    return acct->balance;
+}
+
+void waxlabs::log_proposal_event(uint64_t proposal_id, name proposer, uint8_t old_status, uint8_t new_status)
+{
+    action(permission_level{get_self(), name("active")}, get_self(), name("logpropstat"), make_tuple(
+        proposal_id, //proposal_id
+        proposer, //proposer
+        old_status, //old_status
+        new_status //new_status
+    )).send();
+}
+
+void waxlabs::log_deliverable_event(uint64_t proposal_id, const deliverable& deliv, uint8_t new_status)
+{
+    action(permission_level{get_self(), name("active")}, get_self(), name("logdelvstat"), make_tuple(
+        proposal_id, //proposal_id
+        deliv.deliverable_id, //deliverable_id
+        deliv.status, //old_status
+        new_status, //new_status
+        deliv.requested, //requested
+        deliv.recipient //recipient
+    )).send();
+}
+
+void waxlabs::log_balance_event(name account_owner, asset old_balance, asset new_balance, name reason)
+{
+    action(permission_level{get_self(), name("active")}, get_self(), name("logbalance"), make_tuple(
+        account_owner, //account_owner
+        old_balance, //old_balance
+        new_balance, //new_balance
+        reason //reason
+    )).send();
+}
+
+void waxlabs::refund_draft_slots(name account_owner, uint32_t slots)
+{
+    //get config
+    auto& conf = get_config();
+
+    //initialize
+    asset refund = DRAFT_COST * slots;
+
+    //validate
+    check(conf.available_funds >= refund, "WAX Labs has insufficient available funds");
+
+    //update config funds, the refund reverses the draft transfer
+    conf.available_funds -= refund;
+    save_config();
+    flow_today().withdrawn += refund;
+    log_funds_event(account_owner, refund, name("slotrefund"));
+
+    //inline transfer
+    action(permission_level{get_self(), name("active")}, name("eosio.token"), name("transfer"), make_tuple(
+        get_self(), //from
+        account_owner, //to
+        refund, //quantity
+        std::string("Wax Labs Draft Slot Refund") //memo
+    )).send();
+}
+
+void waxlabs::log_funds_event(name account, asset quantity, name reason)
+{
+    //get config
+    auto& conf = get_config();
+
+    action(permission_level{get_self(), name("active")}, get_self(), name("logfunds"), make_tuple(
+        account, //account
+        quantity, //quantity
+        conf.available_funds, //available_funds
+        conf.deposited_funds, //deposited_funds
+        reason //reason
+    )).send();
+}
+
+waxlabs::proposal_view waxlabs::make_proposal_view(const proposal& prop)
+{
+    //initialize
+    proposal_view view;
+    view.prop = prop;
+
+    //open tables
+    mdbodies_table mdbodies(get_self(), get_self().value);
+    pcomments_table pcomments(get_self(), get_self().value);
+    profiles_table profiles(get_self(), get_self().value);
+    deliverables_table deliverables(get_self(), prop.proposal_id);
+    dcomments_table dcomments(get_self(), prop.proposal_id);
+    dreviewers_table dreviewers(get_self(), get_self().value);
+
+    auto body_itr = mdbodies.find(prop.proposal_id);
+    if (body_itr != mdbodies.end()) {
+        view.mdbody = body_itr->content;
+    }
+
+    auto pcomment_itr = pcomments.find(prop.proposal_id);
+    if (pcomment_itr != pcomments.end()) {
+        view.status_comment = pcomment_itr->status_comment;
+    }
+
+    auto prof_itr = profiles.find(prop.proposer.value);
+    if (prof_itr != profiles.end()) {
+        view.proposer_profile = *prof_itr;
     }
+
+    //comments and reviewers are sparse, walk all tables in deliverable_id order
+    auto dcomment_itr = dcomments.begin();
+    auto drev_itr = dreviewers.lower_bound(waxlabs_keys::deliverable(prop.proposal_id, 0));
+    for (auto deliv_itr = deliverables.begin(); deliv_itr != deliverables.end(); deliv_itr++) {
+        deliverable_view deliv_view;
+        deliv_view.deliv = *deliv_itr;
+        deliv_view.reviewer = prop.reviewer;
+
+        while (drev_itr != dreviewers.end() && drev_itr->proposal_id == prop.proposal_id &&
+            drev_itr->deliverable_id < deliv_itr->deliverable_id) {
+            drev_itr++;
+        }
+        if (drev_itr != dreviewers.end() && drev_itr->proposal_id == prop.proposal_id &&
+            drev_itr->deliverable_id == deliv_itr->deliverable_id) {
+            deliv_view.reviewer = drev_itr->reviewer;
+        }
+
+        while (dcomment_itr != dcomments.end() && dcomment_itr->deliverable_id < deliv_itr->deliverable_id) {
+            dcomment_itr++;
+        }
+        if (dcomment_itr != dcomments.end() && dcomment_itr->deliverable_id == deliv_itr->deliverable_id) {
+            deliv_view.status_comment = dcomment_itr->status_comment;
+        }
+
+        view.deliverables.push_back(deliv_view);
+    }
+
+    return view;
+}
+
+template<typename Index>
+waxlabs::proposal_page waxlabs::walk_proposals(const Index& index, uint128_t lower_bound, uint128_t upper_bound, uint32_t limit)
+{
+    using key_type = decltype(Index::extract_secondary_key(std::declval<proposal>()));
+
+    //validate, lower_bound <= upper_bound is checked by getprops()
+    check(sizeof(key_type) == sizeof(uint128_t) || upper_bound >> 64 == 0, "bounds out of range for this index");
+
+    proposal_page page;
+    auto itr = index.lower_bound(static_cast<key_type>(lower_bound));
+    while (itr != index.end()) {
+        uint128_t key = Index::extract_secondary_key(*itr);
+        if (key > upper_bound) {
+            break;
+        }
+        if (page.proposals.size() == limit) {
+            page.more = true;
+            page.next_key = key;
+            break;
+        }
+        page.proposals.push_back(make_proposal_view(*itr));
+        itr++;
+    }
+
+    return page;
+}
+
+waxlabs::proposal_result waxlabs::make_proposal_result(const proposal& prop)
+{
+    return { prop.proposal_id, prop.status, prop.total_requested_funds, prop.update_ts };
+}
+
+waxlabs::deliverable_result waxlabs::make_deliverable_result(const proposal& prop, const deliverable& deliv)
+{
+    return { prop.proposal_id, deliv.deliverable_id, deliv.status, prop.status, prop.total_requested_funds };
+}
+
+bool waxlabs::did_pass_quorum_thresh(const asset& total_votes, const asset& supply, uint16_t quorum_threshold_bps)
+{
+    //total_votes / supply >= bps / 10000, cross-multiplied so no precision is lost
+    return (uint128_t)total_votes.amount * BPS_DENOMINATOR >= (uint128_t)supply.amount * quorum_threshold_bps;
+}
+
+bool waxlabs::did_pass_yes_thresh(const asset& yes_votes, const asset& total_votes, uint16_t yes_threshold_bps)
+{
+    //yes_votes / total_votes > bps / 10000, cross-multiplied so no precision is lost
+    return (uint128_t)yes_votes.amount * BPS_DENOMINATOR > (uint128_t)total_votes.amount * yes_threshold_bps;
+}
+
+void waxlabs::check_profile_strings(const string& full_name, const string& country, const string& bio,
+    const string& image_url, const string& website, const string& contact, const string& group_name)
+{
+    check(full_name.length() <= MAX_PROFILE_NAME_LEN, "full name string is too long");
+    check(country.length() <= MAX_PROFILE_NAME_LEN, "country string is too long");
+    check(bio.length() <= MAX_BIO_LEN, "bio string is too long");
+    check(image_url.length() <= MAX_IMGURL_LEN, "image URL string is too long");
+    check(website.length() <= MAX_IMGURL_LEN, "website string is too long");
+    check(contact.length() <= MAX_CONTACT_LEN, "contact string is too long");
+    check(group_name.length() <= MAX_PROFILE_NAME_LEN, "group name string is too long");
 }
 
 void waxlabs::inc_stats_count(uint64_t key, string val_name)
 {
-    stats s(_self, _self.value);
-    auto itr = s.find(key);
-    if( itr != s.end() )
-    {
-        s.modify( *itr, same_payer, [&]( auto& row ) {
-            row.current_count += 1;
-            row.total_count += 1;
-        });
-    } else
-    {
-        s.emplace(_self, [&]( auto& row ) {
-            row.key = key;
-            row.val_name = val_name;
-            row.current_count = 1;
-            row.total_count = 1;
-        });
+    auto& entry = load_stat(key);
+    if (!entry.exists) {
+        //row is emplaced on flush
+        entry.row.key = key;
+        entry.row.val_name = val_name;
+        entry.exists = true;
     }
+    entry.row.current_count += 1;
+    entry.row.total_count += 1;
+    entry.dirty = true;
 }
 
 void waxlabs::dec_stats_count(uint64_t key, bool dec_total)
 {
-    stats s(_self, _self.value);
-    auto itr = s.find(key);
-    if ( itr != s.end() )
-    {
-        s.modify( *itr, same_payer, [&]( auto& row ) {
-            row.current_count -= 1;
-            row.total_count -= (dec_total ? 1 : 0);
-        });
+    auto& entry = load_stat(key);
+    if (entry.exists) {
+        entry.row.current_count -= 1;
+        entry.row.total_count -= (dec_total ? 1 : 0);
+        entry.dirty = true;
+    }
+}
+
+void waxlabs::sub_funding(const proposal& prop)
+{
+    auto& entry = load_fundstat(prop.category, prop.status);
+
+    //a missing or short aggregate was not rebuilt after an upgrade or has drifted.
+    //clamp it at zero and count the drift, user actions go on until recompfunds repairs the row
+    bool out_of_step = entry.row.proposals == 0 || entry.row.requested < prop.total_requested_funds ||
+        entry.row.remaining < prop.remaining_funds;
+    if (out_of_step) {
+        entry.row.drift += 1;
+    }
+    entry.row.proposals -= std::min(entry.row.proposals, uint32_t(1));
+    entry.row.requested -= std::min(entry.row.requested, prop.total_requested_funds);
+    entry.row.remaining -= std::min(entry.row.remaining, prop.remaining_funds);
+    entry.dirty = true;
+
+    //a scan in progress has already summed proposals below its cursor
+    if (entry.scanning && prop.proposal_id < entry.scan.next_id) {
+        entry.scan.proposals -= 1;
+        entry.scan.requested -= prop.total_requested_funds;
+        entry.scan.remaining -= prop.remaining_funds;
+        entry.scan_dirty = true;
+    }
+}
+
+void waxlabs::add_funding(const proposal& prop)
+{
+    auto& entry = load_fundstat(prop.category, prop.status);
+    entry.row.proposals += 1;
+    entry.row.requested += prop.total_requested_funds;
+    entry.row.remaining += prop.remaining_funds;
+    entry.dirty = true;
+
+    //a scan in progress won't reach proposals below its cursor
+    if (entry.scanning && prop.proposal_id < entry.scan.next_id) {
+        entry.scan.proposals += 1;
+        entry.scan.requested += prop.total_requested_funds;
+        entry.scan.remaining += prop.remaining_funds;
+        entry.scan_dirty = true;
+    }
+}
+
+waxlabs::fundstat_entry& waxlabs::load_fundstat(uint8_t category, uint8_t status)
+{
+    uint64_t key = waxlabs_keys::category_status(category, status, 0);
+    auto itr = _fundstat_cache.find(key);
+    if (itr == _fundstat_cache.end()) {
+        fundstat_entry entry;
+        trace_row("R", name("fundstats"), get_self().value, key);
+        auto row_itr = _fundstats.find(key);
+        if (row_itr != _fundstats.end()) {
+            entry.row = *row_itr;
+            entry.stored = true;
+        } else {
+            entry.row.category = category;
+            entry.row.status = status;
+        }
+        trace_row("R", name("fundscans"), get_self().value, key);
+        auto scan_itr = _fundscans.find(key);
+        if (scan_itr != _fundscans.end()) {
+            entry.scan = *scan_itr;
+            entry.scanning = true;
+            entry.scan_stored = true;
+        }
+        itr = _fundstat_cache.emplace(key, entry).first;
+    }
+    return itr->second;
+}
+
+waxlabs::stat_entry& waxlabs::load_stat(uint64_t key)
+{
+    auto itr = _stat_cache.find(key);
+    if (itr == _stat_cache.end()) {
+        stat_entry entry;
+        trace_row("R", name("stats"), get_self().value, key);
+        auto row_itr = _stats.find(key);
+        if (row_itr != _stats.end()) {
+            entry.row = *row_itr;
+            entry.exists = true;
+            entry.stored = true;
+        }
+        itr = _stat_cache.emplace(key, entry).first;
+    }
+    return itr->second;
+}
+
+waxlabs::flowday& waxlabs::flow_today()
+{
+    if (!_flow_loaded) {
+        uint32_t day = current_time_point().sec_since_epoch() / 86'400;
+        trace_row("R", name("flowdays"), get_self().value, day);
+        flowdays_table flowdays(get_self(), get_self().value);
+        auto itr = flowdays.find(day);
+        if (itr != flowdays.end()) {
+            _flow = *itr;
+        } else {
+            _flow.day = day;
+        }
+        _flow_loaded = true;
+    }
+    return _flow;
+}
+
+waxlabs::config& waxlabs::get_config()
+{
+    if (!_conf_loaded) {
+        trace_row("R", name("config"), get_self().value, name("config").value);
+        _conf = _configs.get();
+        _conf_loaded = true;
+    }
+    return _conf;
+}
+
+void waxlabs::save_config()
+{
+    _conf_dirty = true;
+}
+
+void waxlabs::flush()
+{
+    if (_conf_dirty) {
+        log_change(name("config"), get_self().value, name("config").value, change_op::modify);
+        _configs.set(_conf, get_self());
+        _conf_dirty = false;
+    }
+
+    for (auto& [key, entry] : _stat_cache) {
+        if (!entry.dirty) {
+            continue;
+        }
+        if (entry.stored) {
+            //row is already in the multi_index cache from load_stat()
+            _stats.modify(_stats.get(key), same_payer, [&](auto& row) {
+                row.current_count = entry.row.current_count;
+                row.total_count = entry.row.total_count;
+            });
+            log_change(name("stats"), get_self().value, key, change_op::modify);
+        } else {
+            _stats.emplace(get_self(), [&](auto& row) {
+                row = entry.row;
+            });
+            log_change(name("stats"), get_self().value, key, change_op::insert);
+            entry.stored = true;
+        }
+        entry.dirty = false;
+    }
+
+    for (auto& [key, entry] : _fundstat_cache) {
+        if (!entry.dirty) {
+            continue;
+        }
+        if (entry.stored && entry.row.proposals == 0 && entry.row.drift == 0) {
+            //release RAM of empty aggregates, drifted ones stay visible until recompfunds
+            _fundstats.erase(_fundstats.get(key));
+            log_change(name("fundstats"), get_self().value, key, change_op::erase);
+            entry.stored = false;
+        } else if (entry.stored) {
+            _fundstats.modify(_fundstats.get(key), same_payer, [&](auto& row) {
+                row = entry.row;
+            });
+            log_change(name("fundstats"), get_self().value, key, change_op::modify);
+        } else if (entry.row.proposals > 0 || entry.row.drift > 0) {
+            _fundstats.emplace(get_self(), [&](auto& row) {
+                row = entry.row;
+            });
+            log_change(name("fundstats"), get_self().value, key, change_op::insert);
+            entry.stored = true;
+        }
+        entry.dirty = false;
+    }
+
+    for (auto& [key, entry] : _fundstat_cache) {
+        if (!entry.scan_dirty) {
+            continue;
+        }
+        if (entry.scanning && entry.scan_stored) {
+            _fundscans.modify(_fundscans.get(key), same_payer, [&](auto& row) {
+                row = entry.scan;
+            });
+            log_change(name("fundscans"), get_self().value, key, change_op::modify);
+        } else if (entry.scanning) {
+            _fundscans.emplace(get_self(), [&](auto& row) {
+                row = entry.scan;
+            });
+            log_change(name("fundscans"), get_self().value, key, change_op::insert);
+            entry.scan_stored = true;
+        } else if (entry.scan_stored) {
+            //scan committed to fundstats
+            log_change(name("fundscans"), get_self().value, key, change_op::erase);
+            _fundscans.erase(_fundscans.get(key));
+            entry.scan_stored = false;
+        }
+        entry.scan_dirty = false;
+    }
+
+    if (_flow_loaded) {
+        flowdays_table flowdays(get_self(), get_self().value);
+        auto flow_itr = flowdays.find(_flow.day);
+        if (flow_itr != flowdays.end()) {
+            flowdays.modify(flow_itr, same_payer, [&](auto& row) {
+                row = _flow;
+            });
+            log_change(name("flowdays"), get_self().value, _flow.day, change_op::modify);
+        } else {
+            flowdays.emplace(get_self(), [&](auto& row) {
+                row = _flow;
+            });
+            log_change(name("flowdays"), get_self().value, _flow.day, change_op::insert);
+
+            //prune days past the retention window, at most two per new day
+            size_t prune_budget = 2;
+            auto old_itr = flowdays.begin();
+            while (old_itr != flowdays.end() && prune_budget > 0 && old_itr->day + FLOW_RETENTION_DAYS <= _flow.day) {
+                log_change(name("flowdays"), get_self().value, old_itr->day, change_op::erase);
+                old_itr = flowdays.erase(old_itr);
+                prune_budget--;
+            }
+        }
+        _flow_loaded = false;
+    }
+
+    if (!_pending_changes.empty()) {
+        changes_table changes(get_self(), get_self().value);
+        trace_row("W", name("changes"), get_self().value, 0); //every append reads and moves the end of the table
+        uint64_t next_seq = changes.available_primary_key();
+        time_point_sec now = time_point_sec(current_time_point());
+
+        for (const auto& pending : _pending_changes) {
+            changes.emplace(get_self(), [&](auto& row) {
+                row = pending;
+                row.seq = next_seq;
+                row.change_ts = now;
+            });
+            next_seq++;
+        }
+
+        //prune rows past the retention window, bounded so one action never pays for a large backlog
+        size_t prune_budget = _pending_changes.size() * 2;
+        auto change_itr = changes.begin();
+        while (change_itr != changes.end() && prune_budget > 0 && next_seq - change_itr->seq > CHANGE_RETENTION) {
+            change_itr = changes.erase(change_itr);
+            prune_budget--;
+        }
+
+        _pending_changes.clear();
     }
 }
 
+void waxlabs::log_change(name table_name, uint64_t scope, uint64_t key, change_op op)
+{
+    trace_row("W", table_name, scope, key);
+
+    //merge with an earlier change of the same row in this action
+    for (auto& pending : _pending_changes) {
+        if (pending.table_name == table_name && pending.scope == scope && pending.key == key) {
+            //insert then modify is still an insert for the consumer
+            if (pending.op == change_op::erase && op == change_op::insert) {
+                pending.op = static_cast<uint8_t>(change_op::modify);
+            } else if (!(pending.op == change_op::insert && op == change_op::modify)) {
+                pending.op = static_cast<uint8_t>(op);
+            }
+            return;
+        }
+    }
+
+    change pending;
+    pending.table_name = table_name;
+    pending.scope = scope;
+    pending.key = key;
+    pending.op = static_cast<uint8_t>(op);
+    _pending_changes.push_back(pending);
+}
+
 void waxlabs::set_pcomment(uint64_t proposal_id, string status_comment, name payer)
 {
     pcomments_table pcomments(_self, _self.value);
@@ -1173,6 +2235,7 @@ void waxlabs::set_pcomment(uint64_t proposal_id, string status_comment, name pay
                 row.proposal_id = proposal_id;
                 row.status_comment = status_comment;
             });
+            log_change(name("pcomments"), get_self().value, proposal_id, change_op::insert);
         }
     }
     else {
@@ -1180,9 +2243,11 @@ void waxlabs::set_pcomment(uint64_t proposal_id, string status_comment, name pay
             pcomments.modify( *itr, payer, [&]( auto& row ) {
                 row.status_comment = status_comment;
             });
+            log_change(name("pcomments"), get_self().value, proposal_id, change_op::modify);
         }
         else {
             pcomments.erase(itr);
+            log_change(name("pcomments"), get_self().value, proposal_id, change_op::erase);
         }
     }
 }
@@ -1190,6 +2255,11 @@ void waxlabs::set_pcomment(uint64_t proposal_id, string status_comment, name pay
 void waxlabs::set_dcomment(uint64_t proposal_id, uint64_t deliverable_id, string status_comment, name payer)
 {
     dcomments_table dcomments(_self, proposal_id);
+    set_dcomment(dcomments, deliverable_id, status_comment, payer);
+}
+
+void waxlabs::set_dcomment(dcomments_table& dcomments, uint64_t deliverable_id, string status_comment, name payer)
+{
     auto itr = dcomments.find(deliverable_id);
     if (itr == dcomments.end() ) {
         if (status_comment.size() > 0 ) {
@@ -1197,6 +2267,7 @@ void waxlabs::set_dcomment(uint64_t proposal_id, uint64_t deliverable_id, string
                 row.deliverable_id = deliverable_id;
                 row.status_comment = status_comment;
             });
+            log_change(name("dcomments"), dcomments.get_scope(), deliverable_id, change_op::insert);
         }
     }
     else {
@@ -1204,16 +2275,40 @@ void waxlabs::set_dcomment(uint64_t proposal_id, uint64_t deliverable_id, string
             dcomments.modify( *itr, payer, [&]( auto& row ) {
                 row.status_comment = status_comment;
             });
+            log_change(name("dcomments"), dcomments.get_scope(), deliverable_id, change_op::modify);
         }
         else {
             dcomments.erase(itr);
+            log_change(name("dcomments"), dcomments.get_scope(), deliverable_id, change_op::erase);
         }
     }
 }
 
+name waxlabs::get_dreviewer(const proposal& prop, uint64_t deliverable_id)
+{
+    dreviewers_table dreviewers(get_self(), get_self().value);
+    auto itr = dreviewers.find(waxlabs_keys::deliverable(prop.proposal_id, deliverable_id));
+    if (itr != dreviewers.end() && itr->deliverable_id == deliverable_id) {
+        return itr->reviewer;
+    }
+    return prop.reviewer;
+}
+
+void waxlabs::rmv_dreviewers(uint64_t proposal_id)
+{
+    dreviewers_table dreviewers(get_self(), get_self().value);
+    auto itr = dreviewers.lower_bound(waxlabs_keys::deliverable(proposal_id, 0));
+    while (itr != dreviewers.end() && itr->proposal_id == proposal_id) {
+        log_change(name("dreviewers"), get_self().value, itr->primary_key(), change_op::erase);
+        itr = dreviewers.erase(itr);
+    }
+}
+
 
 // Temporary actions
 
+#ifdef WAXLABS_MAINTENANCE
+
 ACTION waxlabs::wipestats()
 {
     require_auth(name("ancientsofia"));
@@ -1276,6 +2371,13 @@ ACTION waxlabs::wipeprofiles(uint32_t count)
         profiles.erase(profile_iter);
         done_something = true;
       }
+      profileregs_table profileregs(get_self(), get_self().value);
+      auto reg_iter = profileregs.begin();
+      if(reg_iter != profileregs.end())
+      {
+        profileregs.erase(reg_iter);
+        done_something = true;
+      }
     }
     check(done_something, "nothing left to wipe");
 }
@@ -1325,10 +2427,11 @@ ACTION waxlabs::wipebodies(uint32_t count)
 ACTION waxlabs::wipeconf()
 {
     require_auth(name("ancientsofia"));
-    config_singleton configs(get_self(), get_self().value);
-    configs.remove();
+    _configs.remove();
 }
 
+#endif //WAXLABS_MAINTENANCE
+
 
 
 /*
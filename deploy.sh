@@ -3,6 +3,8 @@
 #contract
 if [[ "$1" == "waxlabs" ]]; then
     contract=waxlabs
+elif [[ "$1" == "decidemock" ]]; then
+    contract=decidemock
 else
     echo "need contract"
     exit 0
@@ -29,4 +31,6 @@ fi
 echo ">>> Deploying $contract contract to $account on $network..."
 
 # eosio v1.8.0
+# signs with $account@deploy, a permission linked to eosio::setcode and eosio::setabi (see README)
+# a waxlabs account with a legacy config row is upgraded with upgrade.sh instead
 cleos -u $url set contract $account ./build/ $contract.wasm $contract.abi -p $account@deploy
@@ -0,0 +1,118 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#account
+account=$2
+
+#network
+if [[ "$3" == "mainnet" ]]; then
+    url=https://wax.greymass.com
+    network="WAX Mainnet"
+elif [[ "$3" == "testnet" ]]; then
+    url=https://testnet.waxsweden.org
+    network="WAX Testnet"
+elif [[ "$3" == "local" ]]; then
+    url=http://127.0.0.1:8888
+    network="Local"
+else
+    echo "need network"
+    exit 0
+fi
+
+outdir=./build/export
+jobs=$(nproc)
+
+echo ">>> Exporting $contract tables from $account on $network to $outdir..."
+
+# requires cleos and jq
+# one JSON object per row is written to $outdir/<table>.jsonl, scoped tables get a "scope" field:
+# the proposal_id for deliverables and dcomments, the account name for accounts
+#
+# this is a convenience export through paginated get_table_rows calls and takes long on a large
+# chain. labsindex builds the same tables from state history, and labsexport writes them as
+# columnar files (see docs/Indexing.md).
+
+mkdir -p $outdir
+
+#dumps every row of one table scope, following next_key pagination
+#the scope is recorded as given, or as the JSON value in $3
+dump_scope() {
+    local table=$1
+    local scope=$2
+    local scope_json=${3:-\"$scope\"}
+    local lower=""
+    while true; do
+        page=$(cleos -u $url get table $account $scope $table --limit 1000 -L "$lower")
+        echo "$page" | jq -c --argjson scope "$scope_json" '.rows[] | . + {scope: $scope}'
+        if [[ $(echo "$page" | jq -r '.more') != "true" ]]; then
+            break
+        fi
+        lower=$(echo "$page" | jq -r '.next_key')
+    done
+}
+
+#integer value of a name-encoded scope, get scope lists numeric scopes as names
+name_value() {
+    local str=$1
+    local charmap=".12345abcdefghijklmnopqrstuvwxyz"
+    local value=0
+    for (( i = 0; i < 13; i++ )); do
+        local c=${str:i:1}
+        local v=0
+        if [[ -n "$c" ]]; then
+            v=${charmap%%"$c"*}
+            v=${#v}
+        fi
+        if (( i < 12 )); then
+            value=$(( value | (v & 0x1f) << (64 - 5 * (i + 1)) ))
+        else
+            value=$(( value | (v & 0x0f) ))
+        fi
+    done
+    printf "%u\n" $value
+}
+export -f dump_scope name_value
+export url account outdir
+
+#lists every scope a table has rows in
+list_scopes() {
+    local table=$1
+    local lower=""
+    while true; do
+        page=$(cleos -u $url get scope $account -t $table --limit 1000 -L "$lower")
+        echo "$page" | jq -r '.rows[].scope'
+        lower=$(echo "$page" | jq -r '.more')
+        if [[ "$lower" == "" || "$lower" == "null" ]]; then
+            break
+        fi
+    done
+}
+
+#contract scoped tables
+for table in config stats fundstats fundscans propcounts countscans flowdays proposals mdbodies pcomments dreviewers profileregs profiles changes; do
+    dump_scope $table $account > $outdir/$table.jsonl &
+done
+
+#tables scoped by proposal_id or account, exported in parallel across scopes
+#each scope goes to its own file first so parallel writers never interleave rows
+for table in deliverables dcomments accounts; do
+    mkdir -p $outdir/$table.d
+    if [[ "$table" == "accounts" ]]; then
+        list_scopes $table | xargs -P $jobs -I {} bash -c "dump_scope $table {} > $outdir/$table.d/{}.jsonl"
+    else
+        list_scopes $table | xargs -P $jobs -I {} bash -c "dump_scope $table {} \$(name_value {}) > $outdir/$table.d/{}.jsonl"
+    fi
+    cat $outdir/$table.d/*.jsonl > $outdir/$table.jsonl 2> /dev/null
+    rm -rf $outdir/$table.d
+done
+
+wait
+
+wc -l $outdir/*.jsonl
@@ -0,0 +1,87 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#account
+account=$2
+
+#admin
+admin=$3
+
+#users, parallel connections and target transactions per second (0 pushes as fast as the connections can)
+users=${4:-100}
+connections=${5:-8}
+tps=${6:-0}
+
+#local network only
+url=http://127.0.0.1:8888
+keosd=${KEOSD_URL:-http://127.0.0.1:8900}
+network="Local"
+
+outdir=./build/loadgen
+rows=$outdir/rows.log
+report=$outdir/report.md
+
+if [[ "$account" == "" || "$admin" == "" || "$LOADGEN_PUBKEY" == "" ]]; then
+    echo "usage: LOADGEN_PUBKEY=<key> ./loadgen.sh waxlabs <account> <admin> [users] [connections] [tps]"
+    exit 0
+fi
+
+if [[ ! -x ./build/tools/labsload ]]; then
+    echo "build/tools/labsload not found, run ./build.sh tools first"
+    exit 1
+fi
+
+echo ">>> Generating load for $contract on $account ($network): $users users, $connections connections, target $tps TPS..."
+
+# requires cleos, jq and an unlocked wallet holding the keys of eosio, <account>, <admin> and LOADGEN_PUBKEY,
+# served over http at KEOSD_URL (default http://127.0.0.1:8900) for labsload
+# eosio must hold enough WAX to fund users, decide is not needed (voting is skipped by admin)
+#
+# the script creates and funds the users, build/tools/labsload (tools/labsload.cpp) runs the
+# full proposal pipeline for every user, one natively packed action per transaction:
+#   newprofile, deposit, draftprop, newdeliv, submitprop, setreviewer, skipvoting,
+#   submitreport, reviewdeliv, claimfunds, withdraw
+#
+# with a target tps, every transaction takes the next send slot from a counter shared by all
+# connections and waits for it, slot n is sent at start + n / tps. a slot sent more than
+# 100 ms late is counted as behind schedule in the report
+#
+# results are written to $outdir:
+#   rows.log        one line per shared row access: user, action, R|W, table, scope, key
+#                   (only with the trace build deployed: ./build.sh waxlabs trace, read by conflicts.sh)
+#   report.md       accepted TPS, per-action CPU distribution, busiest blocks and hottest rows
+
+mkdir -p $outdir
+
+#maps a user index to a valid account name, digits become letters
+user_name() {
+    echo "lgu$(echo $1 | tr '0-9' 'a-j')"
+}
+
+#create and fund users, fund contract for every proposal
+echo ">>> Creating $users users..."
+for i in $(seq 1 $users); do
+    user=$(user_name $i)
+    cleos -u $url get account $user > /dev/null 2>&1 || \
+        cleos -u $url create account eosio $user $LOADGEN_PUBKEY $LOADGEN_PUBKEY > /dev/null
+    cleos -u $url push action eosio.token transfer "[\"eosio\", \"$user\", \"1200.00000000 WAX\", \"\"]" -p eosio > /dev/null
+done
+cleos -u $url push action eosio.token transfer "[\"eosio\", \"$account\", \"$users""000.00000000 WAX\", \"fund\"]" -p eosio > /dev/null
+
+#admin signs setreviewer, skipvoting and reviewdeliv with its active key
+admin_pubkey=$(cleos -u $url get account $admin -j | jq -r '.permissions[] | select(.perm_name == "active") | .required_auth.keys[0].key')
+
+#run load and report
+echo ">>> Running pipeline..."
+./build/tools/labsload $url $keosd $account $admin $admin_pubkey $LOADGEN_PUBKEY $users $rows $connections $tps > $report
+status=$?
+
+cat $report
+exit $status
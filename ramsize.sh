@@ -0,0 +1,40 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#store
+store=$2
+if [[ ! -f "$store" ]]; then
+    echo "need a labsindex store"
+    exit 0
+fi
+
+# requires the native tools (./build.sh tools) and a store of the tables to measure:
+#   build/tools/labsindex sync <store> <host> <port> <account>
+#
+# labsramsize encodes every proposals, deliverables, accounts and stats row with the compact
+# layouts of contracts/waxlabs/include/waxlabs_compact.hpp and checks that each row reads back
+# to the stored bytes before it is counted. the RAM billed per row also includes a fixed 112
+# byte row overhead that no encoding changes
+
+tool=./build/tools/labsramsize
+report=./build/$contract.ramsize.md
+
+if [[ ! -x $tool ]]; then
+    echo "$tool not found, run ./build.sh tools"
+    exit 1
+fi
+
+echo ">>> Writing $contract row size report to $report..."
+
+echo "# $contract row size report" > $report
+echo "" >> $report
+$tool $store >> $report || exit 1
+
+cat $report
@@ -0,0 +1,132 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#mode
+if [[ "$2" == "" || "$2" == "compare" || "$2" == "check" || "$2" == "baseline" ]]; then
+    mode=${2:-compare}
+else
+    echo "unknown mode, use compare, check or baseline"
+    exit 0
+fi
+
+# requires both variants to be built first:
+#   ./build.sh waxlabs && ./build.sh waxlabs maintenance
+#
+# wabt (wasm-objdump) and node are used when available, otherwise those columns are reported as n/a
+#
+# the tracked baseline is docs/<contract>.report.md. every mode writes the report and its sizes
+# against the baseline. baseline replaces the tracked report with this one, commit it with the
+# contract change. check exits 1 when wasm bytes, abi bytes or functions differ from the baseline,
+# compile ms is host dependent and never compared. without a baseline check only reports.
+
+report=./build/$contract.report.md
+baseline=./docs/$contract.report.md
+
+echo ">>> Writing $contract WASM report to $report..."
+
+echo "# $contract WASM report" > $report
+echo "" >> $report
+echo "| variant | wasm bytes | abi bytes | functions | compile ms |" >> $report
+echo "|---|---|---|---|---|" >> $report
+
+for variant in production maintenance; do
+    if [[ "$variant" == "production" ]]; then
+        outdir=./build
+    else
+        outdir=./build/$variant
+    fi
+
+    wasm=$outdir/$contract.wasm
+    abi=$outdir/$contract.abi
+
+    if [[ ! -f $wasm ]]; then
+        echo "| $variant | not built | | | |" >> $report
+        continue
+    fi
+
+    wasm_size=$(wc -c < $wasm)
+    abi_size=$(wc -c < $abi)
+
+    #number of defined functions (imports excluded)
+    functions=n/a
+    if command -v wasm-objdump > /dev/null; then
+        functions=$(wasm-objdump -h $wasm | sed -n 's/.*Function .*count: \([0-9]*\).*/\1/p')
+    fi
+
+    #time to compile the module locally, best of 5 runs
+    compile_ms=n/a
+    if command -v node > /dev/null; then
+        compile_ms=$(node -e '
+            const bytes = require("fs").readFileSync(process.argv[1]);
+            let best = Infinity;
+            for (let i = 0; i < 5; i++) {
+                const start = process.hrtime.bigint();
+                new WebAssembly.Module(bytes);
+                best = Math.min(best, Number(process.hrtime.bigint() - start) / 1e6);
+            }
+            console.log(best.toFixed(2));
+        ' $wasm)
+    fi
+
+    echo "| $variant | $wasm_size | $abi_size | $functions | $compile_ms |" >> $report
+done
+
+if [[ "$mode" == "baseline" ]]; then
+    cp $report $baseline
+    echo ">>> Baseline $baseline updated, commit it with the contract change"
+    cat $report
+    exit 0
+fi
+
+#sizes against the tracked baseline, columns 3 to 5 of each variant row
+#prints "changed" when a size differs, "unmeasured" when the baseline or this build lacks the variant
+diff_rows() {
+    awk -F'|' '
+        function trim(s) { gsub(/^ +| +$/, "", s); return s }
+        function delta(a, b) {
+            if (a !~ /^[0-9]+$/ || b !~ /^[0-9]+$/) return "n/a"
+            return (b - a >= 0 ? "+" : "") (b - a)
+        }
+        FNR == 1 { file++ }
+        file == 1 && $2 ~ /production|maintenance/ { for (i = 3; i <= 5; i++) base[trim($2), i] = trim($i) }
+        file == 2 && $2 ~ /production|maintenance/ {
+            v = trim($2)
+            printf "| %s | %s | %s | %s |\n", v, delta(base[v, 3], trim($3)), delta(base[v, 4], trim($4)), delta(base[v, 5], trim($5)) > "/dev/stderr"
+            for (i = 3; i <= 5; i++) {
+                if (base[v, i] !~ /^[0-9]+$/ || trim($i) !~ /^[0-9]+$/) { if (i < 5) unmeasured = 1 }
+                else if (base[v, i] != trim($i)) changed = 1
+            }
+        }
+        END { print changed ? "changed" : unmeasured ? "unmeasured" : "same" }
+    ' $baseline $report
+}
+
+if [[ ! -f $baseline ]]; then
+    echo "" >> $report
+    echo "No baseline at $baseline, record one with ./report.sh $contract baseline" >> $report
+    cat $report
+    exit 0
+fi
+
+echo "" >> $report
+echo "## Against $baseline" >> $report
+echo "" >> $report
+echo "| variant | wasm bytes | abi bytes | functions |" >> $report
+echo "|---|---|---|---|" >> $report
+result=$(diff_rows 2>> $report)
+echo "" >> $report
+echo "sizes against the baseline: $result" >> $report
+
+cat $report
+
+if [[ "$mode" == "check" && "$result" == "changed" ]]; then
+    echo ">>> Contract sizes differ from $baseline, run ./report.sh $contract baseline and commit it"
+    exit 1
+fi
@@ -0,0 +1,461 @@
+// labsbench: native codec and client against generic ABI serialization.
+//
+// Decoding: packs a set of proposals rows with the usual string sizes. Then
+// each row is decoded two ways. The first is the waxlabs_codec decoder. The
+// second is a runtime decoder that walks an ABI struct definition and writes
+// JSON, the way abieos and the chain API turn table rows into JSON. Both run
+// over the same buffer.
+//
+// Encoding: builds the same number of draftprop actions. Each is packed by
+// waxlabs_client from its argument struct, and by a runtime encoder that
+// parses the JSON arguments and walks the ABI, the work abi_json_to_bin does
+// inside nodeos. The generic figure leaves out the HTTP round trip that
+// abi_json_to_bin adds on top.
+//
+// The tool reports time and heap allocations per row for each.
+//
+//   labsbench [rows] [rounds]
+//
+// Defaults are 100000 rows and 5 rounds. The best round is reported.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "waxlabs_client.hpp"
+#include "waxlabs_codec.hpp"
+
+using waxlabs_codec::name;
+using waxlabs_codec::reader;
+
+//======================== allocation counter ========================
+
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
+//======================== generic abi decoder ========================
+
+struct abi_field {
+    std::string name;
+    std::string type;
+};
+
+struct abi {
+    std::map<std::string, std::vector<abi_field>> structs;
+};
+
+//proposals row, its map entry and draftprop as they appear in the contract abi
+abi waxlabs_abi() {
+    abi def;
+    def.structs["pair_name_asset"] = { {"key", "name"}, {"value", "asset"} };
+    def.structs["draftprop"] = {
+        {"title", "string"}, {"description", "string"}, {"mdbody", "string"}, {"proposer", "name"},
+        {"image_url", "string"}, {"estimated_time", "uint32"}, {"category", "name"}, {"road_map", "string"}
+    };
+    def.structs["proposal"] = {
+        {"proposal_id", "uint64"}, {"proposer", "name"}, {"category", "uint8"}, {"status", "uint8"},
+        {"ballot_name", "name"}, {"title", "string"}, {"description", "string"}, {"image_url", "string"},
+        {"estimated_time", "uint32"}, {"total_requested_funds", "asset"}, {"remaining_funds", "asset"},
+        {"deliverables", "uint8"}, {"deliverables_completed", "uint8"}, {"reviewer", "name"},
+        {"ballot_results", "pair_name_asset[]"}, {"update_ts", "time_point_sec"},
+        {"vote_end_time", "time_point_sec"}, {"road_map", "string"}
+    };
+    return def;
+}
+
+template<typename T>
+bool read_value(reader& rd, T& value) {
+    waxlabs_codec::read(rd, value);
+    return rd.ok;
+}
+
+void write_string(std::string& json, std::string_view str) {
+    json += '"';
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            json += '\\';
+            json += c;
+        } else if (uint8_t(c) < 0x20) {
+            char esc[8];
+            std::snprintf(esc, sizeof(esc), "\\u%04x", c);
+            json += esc;
+        } else {
+            json += c;
+        }
+    }
+    json += '"';
+}
+
+std::string asset_string(const waxlabs_codec::asset& value) {
+    uint8_t precision = value.symbol & 0xff;
+    std::string code;
+    for (uint64_t sym = value.symbol >> 8; sym; sym >>= 8) code += char(sym & 0xff);
+    int64_t scale = 1;
+    for (uint8_t i = 0; i < precision; i++) scale *= 10;
+    std::string amount = std::to_string(value.amount / scale);
+    if (precision) {
+        std::string frac = std::to_string(std::llabs(value.amount % scale) + scale).substr(1);
+        amount += "." + frac;
+    }
+    return amount + " " + code;
+}
+
+//decodes one value of type to JSON, false when the data runs out
+bool bin_to_json(const abi& def, const std::string& type, reader& rd, std::string& json) {
+    if (type.size() > 2 && type.compare(type.size() - 2, 2, "[]") == 0) {
+        std::string element = type.substr(0, type.size() - 2);
+        uint32_t size = rd.varuint32();
+        json += '[';
+        for (uint32_t i = 0; i < size && rd.ok; i++) {
+            if (i) json += ',';
+            if (!bin_to_json(def, element, rd, json)) return false;
+        }
+        json += ']';
+        return rd.ok;
+    }
+    if (type == "uint8") {
+        uint8_t value;
+        if (!read_value(rd, value)) return false;
+        json += std::to_string(value);
+    } else if (type == "uint32") {
+        uint32_t value;
+        if (!read_value(rd, value)) return false;
+        json += std::to_string(value);
+    } else if (type == "uint64") {
+        uint64_t value;
+        if (!read_value(rd, value)) return false;
+        json += std::to_string(value);
+    } else if (type == "name") {
+        uint64_t value;
+        if (!read_value(rd, value)) return false;
+        write_string(json, name(value).to_string());
+    } else if (type == "time_point_sec") {
+        uint32_t value;
+        if (!read_value(rd, value)) return false;
+        json += std::to_string(value);
+    } else if (type == "string") {
+        std::string_view value;
+        if (!read_value(rd, value)) return false;
+        write_string(json, value);
+    } else if (type == "asset") {
+        waxlabs_codec::asset value;
+        if (!read_value(rd, value)) return false;
+        write_string(json, asset_string(value));
+    } else {
+        auto itr = def.structs.find(type);
+        if (itr == def.structs.end()) return false;
+        json += '{';
+        bool first = true;
+        for (const auto& field : itr->second) {
+            if (!first) json += ',';
+            first = false;
+            write_string(json, field.name);
+            json += ':';
+            if (!bin_to_json(def, field.type, rd, json)) return false;
+        }
+        json += '}';
+    }
+    return rd.ok;
+}
+
+//======================== generic abi encoder ========================
+
+//parsed JSON document, the variant abi_json_to_bin builds before packing
+struct json_value {
+    enum kind_t { null, boolean, number, string, array, object } kind = null;
+    bool flag = false;
+    double num = 0;
+    std::string str;
+    std::vector<json_value> items;
+    std::map<std::string, json_value> members;
+};
+
+struct json_parser {
+    const char* pos;
+    const char* end;
+
+    void skip() {
+        while (pos < end && (*pos == ' ' || *pos == '\n' || *pos == '\t' || *pos == '\r')) pos++;
+    }
+
+    bool parse_string(std::string& out) {
+        if (pos == end || *pos != '"') return false;
+        for (pos++; pos < end && *pos != '"'; pos++) {
+            if (*pos == '\\') {
+                if (++pos == end) return false;
+                if (*pos == 'u') {
+                    if (end - pos < 5) return false;
+                    out += char(std::strtoul(std::string(pos + 1, 4).c_str(), nullptr, 16));
+                    pos += 4;
+                    continue;
+                }
+                out += *pos == 'n' ? '\n' : *pos == 't' ? '\t' : *pos;
+            } else {
+                out += *pos;
+            }
+        }
+        if (pos == end) return false;
+        pos++;
+        return true;
+    }
+
+    bool parse(json_value& value) {
+        skip();
+        if (pos == end) return false;
+        if (*pos == '"') {
+            value.kind = json_value::string;
+            return parse_string(value.str);
+        }
+        if (*pos == '{') {
+            value.kind = json_value::object;
+            pos++;
+            skip();
+            if (pos < end && *pos == '}') return ++pos, true;
+            while (true) {
+                std::string key;
+                skip();
+                if (!parse_string(key)) return false;
+                skip();
+                if (pos == end || *pos++ != ':') return false;
+                if (!parse(value.members[key])) return false;
+                skip();
+                if (pos == end) return false;
+                if (*pos == '}') return ++pos, true;
+                if (*pos++ != ',') return false;
+            }
+        }
+        if (*pos == '[') {
+            value.kind = json_value::array;
+            pos++;
+            skip();
+            if (pos < end && *pos == ']') return ++pos, true;
+            while (true) {
+                value.items.emplace_back();
+                if (!parse(value.items.back())) return false;
+                skip();
+                if (pos == end) return false;
+                if (*pos == ']') return ++pos, true;
+                if (*pos++ != ',') return false;
+            }
+        }
+        if (end - pos >= 4 && std::string_view(pos, 4) == "null") return pos += 4, true;
+        if (end - pos >= 4 && std::string_view(pos, 4) == "true") {
+            value.kind = json_value::boolean;
+            value.flag = true;
+            return pos += 4, true;
+        }
+        if (end - pos >= 5 && std::string_view(pos, 5) == "false") {
+            value.kind = json_value::boolean;
+            return pos += 5, true;
+        }
+        char* after;
+        value.kind = json_value::number;
+        value.num = std::strtod(pos, &after);
+        if (after == pos) return false;
+        pos = after;
+        return true;
+    }
+};
+
+//packs one JSON value of type, false when it does not match
+bool json_to_bin(const abi& def, const std::string& type, const json_value& value, waxlabs_client::writer& wr) {
+    if (type == "string") {
+        if (value.kind != json_value::string) return false;
+        waxlabs_client::write(wr, value.str);
+    } else if (type == "name") {
+        if (value.kind != json_value::string) return false;
+        waxlabs_client::write(wr, name(value.str));
+    } else if (type == "uint32") {
+        if (value.kind != json_value::number) return false;
+        waxlabs_client::write(wr, uint32_t(value.num));
+    } else {
+        auto itr = def.structs.find(type);
+        if (itr == def.structs.end() || value.kind != json_value::object) return false;
+        for (const auto& field : itr->second) {
+            auto member = value.members.find(field.name);
+            if (member == value.members.end() || !json_to_bin(def, field.type, member->second, wr)) return false;
+        }
+    }
+    return true;
+}
+
+//======================== rows ========================
+
+std::string text(size_t size, uint64_t seed) {
+    std::string str(size, ' ');
+    for (size_t i = 0; i < size; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        str[i] = "abcdefghijklmnopqrstuvwxyz     .,"[(seed >> 33) % 33];
+    }
+    return str;
+}
+
+std::string packed_proposal(uint64_t id) {
+    using namespace waxlabs_client;
+    std::string out;
+    writer wr{out};
+    write(wr, id);
+    write(wr, name(id % 2 ? "alice" : "bob"));
+    write(wr, uint8_t(id % 8));
+    write(wr, uint8_t(1 + id % 9));
+    write(wr, name("ballot"));
+    write(wr, text(48, id));
+    write(wr, text(140, id + 1));
+    write(wr, text(60, id + 2));
+    write(wr, uint32_t(90));
+    write(wr, wax(5000000000000));
+    write(wr, wax(2500000000000));
+    write(wr, uint8_t(5));
+    write(wr, uint8_t(2));
+    write(wr, name("reviewer"));
+    wr.varuint32(2);
+    write(wr, name("no"));
+    write(wr, asset{0, 8 | uint64_t('V') << 8 | uint64_t('O') << 16 | uint64_t('T') << 24 | uint64_t('E') << 32});
+    write(wr, name("yes"));
+    write(wr, asset{0, 8 | uint64_t('V') << 8 | uint64_t('O') << 16 | uint64_t('T') << 24 | uint64_t('E') << 32});
+    write(wr, uint32_t(1600000000 + id));
+    write(wr, uint32_t(1600600000 + id));
+    write(wr, text(1200, id + 3));
+    return out;
+}
+
+waxlabs_client::draftprop draft_args(uint64_t id) {
+    return waxlabs_client::draftprop{text(48, id), text(140, id + 1), text(2000, id + 2), name(id % 2 ? "alice" : "bob"),
+        text(60, id + 3), 90, name("marketing"), text(1200, id + 4)};
+}
+
+//draftprop arguments as a JSON client sends them to abi_json_to_bin
+std::string draft_json(uint64_t id) {
+    auto args = draft_args(id);
+    std::string json = "{\"title\":";
+    write_string(json, args.title);
+    json += ",\"description\":";
+    write_string(json, args.description);
+    json += ",\"mdbody\":";
+    write_string(json, args.mdbody);
+    json += ",\"proposer\":\"" + args.proposer.to_string() + "\",\"image_url\":";
+    write_string(json, args.image_url);
+    json += ",\"estimated_time\":" + std::to_string(args.estimated_time);
+    json += ",\"category\":\"" + args.category.to_string() + "\",\"road_map\":";
+    write_string(json, args.road_map);
+    return json + "}";
+}
+
+//======================== benchmark ========================
+
+struct result {
+    double ns_per_row = 0;
+    double allocs_per_row = 0;
+    uint64_t check = 0;
+};
+
+template<typename Row, typename F>
+result run(const std::vector<Row>& rows, int rounds, F&& decode) {
+    result best;
+    for (int round = 0; round < rounds; round++) {
+        size_t before = allocations;
+        uint64_t check = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& row : rows) {
+            check += decode(row);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        double ns = elapsed / rows.size();
+        if (round == 0 || ns < best.ns_per_row) {
+            best.ns_per_row = ns;
+            best.allocs_per_row = double(allocations - before) / rows.size();
+            best.check = check;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 5;
+    if (count == 0 || rounds <= 0) {
+        std::fprintf(stderr, "usage: labsbench [rows] [rounds]\n");
+        return 1;
+    }
+
+    std::vector<std::string> rows;
+    rows.reserve(count);
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        rows.push_back(packed_proposal(i));
+        total += rows.back().size();
+    }
+
+    //codec: decode and read every fixed field and string length
+    auto codec = run(rows, rounds, [](const std::string& row) -> uint64_t {
+        waxlabs_codec::proposal prop;
+        if (!waxlabs_codec::decode(row.data(), row.size(), prop)) std::abort();
+        return prop.proposal_id + prop.status + prop.title.size() + prop.road_map.size() + prop.ballot_results.size;
+    });
+
+    //generic: abi walk to a JSON document, the form a JSON client receives
+    const abi def = waxlabs_abi();
+    const std::string type = "proposal";
+    auto generic = run(rows, rounds, [&](const std::string& row) -> uint64_t {
+        std::string json;
+        reader rd{row.data(), row.data() + row.size()};
+        if (!bin_to_json(def, type, rd, json) || rd.pos != rd.end) std::abort();
+        return json.size();
+    });
+
+    //client: pack typed arguments into a complete action
+    std::vector<waxlabs_client::draftprop> drafts;
+    std::vector<std::string> draft_texts;
+    drafts.reserve(count);
+    draft_texts.reserve(count);
+    size_t draft_total = 0;
+    for (size_t i = 0; i < count; i++) {
+        drafts.push_back(draft_args(i));
+        draft_texts.push_back(draft_json(i));
+        draft_total += draft_texts.back().size();
+    }
+    auto client = run(drafts, rounds, [](const waxlabs_client::draftprop& args) -> uint64_t {
+        return waxlabs_client::make_action(name("labs.wax"), args.proposer, args).data.size();
+    });
+
+    //generic: parse the JSON arguments, then walk the abi to pack them
+    const std::string action_type = "draftprop";
+    auto generic_enc = run(draft_texts, rounds, [&](const std::string& json) -> uint64_t {
+        json_value value;
+        json_parser parser{json.data(), json.data() + json.size()};
+        if (!parser.parse(value)) std::abort();
+        std::string data;
+        waxlabs_client::writer wr{data};
+        if (!json_to_bin(def, action_type, value, wr)) std::abort();
+        return data.size();
+    });
+
+    std::printf("proposals rows: %zu, mean packed size: %zu bytes, best of %d rounds\n\n", count, total / count, rounds);
+    std::printf("| Decoder | ns/row | allocations/row |\n");
+    std::printf("|---|---|---|\n");
+    std::printf("| waxlabs_codec | %.1f | %.2f |\n", codec.ns_per_row, codec.allocs_per_row);
+    std::printf("| generic abi to JSON | %.1f | %.2f |\n", generic.ns_per_row, generic.allocs_per_row);
+    std::printf("\nspeedup: %.1fx (checks %llu %llu)\n", generic.ns_per_row / codec.ns_per_row,
+        (unsigned long long)codec.check, (unsigned long long)generic.check);
+
+    std::printf("\ndraftprop actions: %zu, mean JSON size: %zu bytes, best of %d rounds\n\n", count, draft_total / count, rounds);
+    std::printf("| Encoder | ns/action | allocations/action |\n");
+    std::printf("|---|---|---|\n");
+    std::printf("| waxlabs_client make_action | %.1f | %.2f |\n", client.ns_per_row, client.allocs_per_row);
+    std::printf("| generic JSON to abi | %.1f | %.2f |\n", generic_enc.ns_per_row, generic_enc.allocs_per_row);
+    std::printf("\nspeedup: %.1fx (checks %llu %llu)\n", generic_enc.ns_per_row / client.ns_per_row,
+        (unsigned long long)client.check, (unsigned long long)generic_enc.check);
+    return 0;
+}
@@ -0,0 +1,220 @@
+// labsexport: columnar export of a labsindex store.
+//
+// Writes every contract table of a waxlabs_store file to one waxlabs_columns
+// file per table. The rows are split into chunks of one table and scope, at
+// most CHUNK_ROWS rows each, and the chunks are decoded on all cores at once.
+// A store is built from state history with labsindex sync, or from a
+// recorded fixture with labsindex replay.
+//
+//   labsexport export <store> <outdir> [threads]
+//   labsexport load <store> <file>...
+//   labsexport info <file>
+//
+// export writes <outdir>/<table>.wlc. load seeds an empty store from column
+// files, so a harness or a labsindex sync starts from the exported state at
+// its last block. info prints the columns of a file.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "waxlabs_columns.hpp"
+#include "waxlabs_store.hpp"
+
+using waxlabs_codec::name;
+
+constexpr size_t CHUNK_ROWS = 4096;
+
+//rows of one table and scope, decoded by one worker
+struct chunk {
+    uint64_t table;
+    waxlabs_store::row_index::const_iterator begin, end;
+    waxlabs_store::proposal_index::index<waxlabs_store::by_id>::type::const_iterator proposals_begin, proposals_end;
+};
+
+size_t store_size() {
+    const char* mb = std::getenv("LABSINDEX_MB");
+    return size_t(mb ? std::strtoull(mb, nullptr, 10) : 1024) << 20;
+}
+
+//splits the store into chunks, grouped by table in store order
+std::map<uint64_t, std::vector<chunk>> split(const waxlabs_store::store& st) {
+    std::map<uint64_t, std::vector<chunk>> tables;
+
+    auto& by_pk = st.proposals().get<waxlabs_store::by_id>();
+    for (auto itr = by_pk.begin(); itr != by_pk.end();) {
+        chunk ch{waxlabs_columns::PROPOSALS, {}, {}, itr, itr};
+        for (size_t n = 0; n < CHUNK_ROWS && ch.proposals_end != by_pk.end(); n++) ch.proposals_end++;
+        tables[ch.table].push_back(ch);
+        itr = ch.proposals_end;
+    }
+
+    auto& rows = st.rows();
+    for (auto itr = rows.begin(); itr != rows.end();) {
+        chunk ch{itr->table, itr, itr, {}, {}};
+        size_t n = 0;
+        while (ch.end != rows.end() && ch.end->table == itr->table && ch.end->scope == itr->scope && n < CHUNK_ROWS) {
+            ch.end++;
+            n++;
+        }
+        tables[ch.table].push_back(ch);
+        itr = ch.end;
+    }
+    return tables;
+}
+
+void decode(const chunk& ch, waxlabs_columns::column_set& cols) {
+    if (ch.table == waxlabs_columns::PROPOSALS) {
+        for (auto itr = ch.proposals_begin; itr != ch.proposals_end; ++itr) {
+            waxlabs_columns::add_row(cols, ch.table, 0, itr->proposal_id, itr->data.data(), itr->data.size());
+        }
+        return;
+    }
+    for (auto itr = ch.begin; itr != ch.end; ++itr) {
+        waxlabs_columns::add_row(cols, ch.table, itr->scope, itr->primary_key, itr->data.data(), itr->data.size());
+    }
+}
+
+int run_export(const std::string& path, const std::string& outdir, size_t threads) {
+    waxlabs_store::store st(path, store_size());
+    auto lock = st.read_lock();
+    std::filesystem::create_directories(outdir);
+
+    auto started = std::chrono::steady_clock::now();
+    auto tables = split(st);
+
+    //one flat work list, so small tables don't leave cores idle
+    std::vector<const chunk*> work;
+    std::vector<waxlabs_columns::column_set*> results;
+    std::map<uint64_t, std::vector<waxlabs_columns::column_set>> decoded;
+    for (auto& table : tables) {
+        auto& sets = decoded[table.first];
+        sets.resize(table.second.size());
+        for (size_t i = 0; i < table.second.size(); i++) {
+            work.push_back(&table.second[i]);
+            results.push_back(&sets[i]);
+        }
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<std::string> errors(threads);
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < threads; w++) {
+        workers.emplace_back([&, w]() {
+            try {
+                for (size_t i = next++; i < work.size(); i = next++) {
+                    decode(*work[i], *results[i]);
+                }
+            } catch (const std::exception& e) {
+                errors[w] = e.what();
+                next = work.size();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    for (const auto& error : errors) {
+        if (!error.empty()) throw std::runtime_error(error);
+    }
+    auto decoded_at = std::chrono::steady_clock::now();
+
+    std::printf("| Table | Rows | Columns | Bytes |\n");
+    std::printf("|---|---|---|---|\n");
+    uint64_t total_rows = 0, total_bytes = 0;
+    for (auto& table : decoded) {
+        std::string table_name = name(table.first).to_string();
+        uint64_t bytes = waxlabs_columns::write_table(outdir + "/" + table_name + ".wlc", st.state().contract,
+            st.state().last_block, table.first, table.second);
+        uint64_t rows = 0;
+        for (const auto& set : table.second) rows += set.rows();
+        size_t columns = table.second.empty() ? 0 : table.second.front().columns().size();
+        std::printf("| %s | %llu | %zu | %llu |\n", table_name.c_str(), (unsigned long long)rows, columns, (unsigned long long)bytes);
+        total_rows += rows;
+        total_bytes += bytes;
+    }
+    auto written_at = std::chrono::steady_clock::now();
+
+    double decode_s = std::chrono::duration<double>(decoded_at - started).count();
+    double write_s = std::chrono::duration<double>(written_at - decoded_at).count();
+    std::cerr << total_rows << " rows in " << work.size() << " chunks decoded in " << decode_s << " s on " << threads
+        << " threads, " << total_bytes << " bytes written in " << write_s << " s, last block " << st.state().last_block << std::endl;
+    return 0;
+}
+
+int load(const std::string& path, const std::vector<std::string>& files) {
+    std::vector<waxlabs_columns::table_file> tables;
+    for (const auto& file : files) {
+        tables.emplace_back(file);
+        if (tables.back().contract() != tables.front().contract() || tables.back().last_block() != tables.front().last_block()) {
+            throw std::runtime_error(file + " is from another export");
+        }
+    }
+
+    waxlabs_store::store st(path, store_size());
+    auto lock = st.write_lock();
+    if (st.state().last_block != 0 || !st.proposals().empty() || !st.rows().empty()) {
+        throw std::runtime_error("store is not empty");
+    }
+    st.set_contract(tables.front().contract());
+
+    auto started = std::chrono::steady_clock::now();
+    uint64_t rows = 0;
+    st.begin_block();
+    for (const auto& tbl : tables) {
+        waxlabs_columns::for_each_row(tbl, [&](uint64_t scope, uint64_t primary_key, std::string_view packed) {
+            st.apply(tbl.table(), scope, primary_key, true, packed.data(), packed.size());
+            rows++;
+        });
+    }
+    st.commit_block(tables.front().last_block());
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "loaded " << rows << " rows of " << tables.size() << " tables in " << seconds << " s, last block "
+        << st.state().last_block << ", " << st.proposals().size() << " proposals, " << st.rows().size() << " other rows" << std::endl;
+    return 0;
+}
+
+int info(const std::string& file) {
+    waxlabs_columns::table_file tbl(file);
+    std::cout << "contract\t" << name(tbl.contract()).to_string() << std::endl;
+    std::cout << "last block\t" << tbl.last_block() << std::endl;
+    std::cout << "table\t" << name(tbl.table()).to_string() << std::endl;
+    std::cout << "rows\t" << tbl.rows() << std::endl;
+    static const char* type_names[] = { "", "uint8", "uint16", "uint32", "uint64", "int64", "bytes" };
+    for (const auto& col : tbl.columns()) {
+        std::cout << col.name << "\t" << type_names[size_t(col.type)] << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string cmd = argc > 1 ? argv[1] : "";
+    try {
+        if (cmd == "export" && (argc == 4 || argc == 5)) {
+            size_t threads = argc == 5 ? std::strtoull(argv[4], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+            if (threads > 0) {
+                return run_export(argv[2], argv[3], threads);
+            }
+        } else if (cmd == "load" && argc >= 4) {
+            return load(argv[2], std::vector<std::string>(argv + 3, argv + argc));
+        } else if (cmd == "info" && argc == 3) {
+            return info(argv[2]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "usage:" << std::endl
+        << "  labsexport export <store> <outdir> [threads]" << std::endl
+        << "  labsexport load <store> <file>..." << std::endl
+        << "  labsexport info <file>" << std::endl;
+    return 1;
+}
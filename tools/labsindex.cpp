@@ -0,0 +1,437 @@
+// labsindex: native WAX Labs indexer.
+//
+// Follows the contract tables from a nodeos state-history (SHiP) websocket
+// or from a recorded fixture file and keeps them in a waxlabs_store file.
+// Only irreversible blocks are requested, so the store never has to undo a
+// fork, and a restart resumes at the block after the last one applied.
+//
+//   labsindex sync <store> <host> <port> <contract> [fixture]
+//   labsindex replay <store> <fixture> <contract>
+//   labsindex get <store> <proposal_id>
+//   labsindex walk <store> <index> <lower_bound> <upper_bound> [limit]
+//   labsindex info <store>
+//   labsindex search <store>
+//
+// sync also appends every received message to fixture when one is given.
+// search reads one query per line from stdin, see run_search.
+// LABSINDEX_MB sets the size of a new store file (default 1024).
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket.hpp>
+
+#include "waxlabs_codec.hpp"
+#include "waxlabs_search.hpp"
+#include "waxlabs_store.hpp"
+
+namespace asio = boost::asio;
+namespace beast = boost::beast;
+using tcp = asio::ip::tcp;
+
+using waxlabs_codec::name;
+using waxlabs_codec::reader;
+using waxlabs_codec::read;
+
+//ship variant indices of the request and result types used here
+constexpr uint32_t GET_BLOCKS_REQUEST_V0 = 1;
+constexpr uint32_t GET_BLOCKS_ACK_REQUEST_V0 = 2;
+constexpr uint32_t GET_BLOCKS_RESULT_V0 = 1;
+constexpr uint32_t TABLE_DELTA_V0 = 0;
+constexpr uint32_t CONTRACT_ROW_V0 = 0;
+
+constexpr uint32_t MAX_MESSAGES_IN_FLIGHT = 1000;
+
+//======================== ship decoding ========================
+
+struct block_position {
+    uint32_t block_num = 0;
+    std::string_view block_id;
+};
+
+void read(reader& rd, block_position& pos) {
+    read(rd, pos.block_num);
+    if (rd.take(32)) {
+        pos.block_id = std::string_view(rd.pos, 32);
+        rd.pos += 32;
+    }
+}
+
+bool read_flag(reader& rd) {
+    uint8_t flag = 0;
+    read(rd, flag);
+    return flag != 0;
+}
+
+//applies the contract_row deltas of one get_blocks_result, returns the block applied or 0
+uint32_t apply_result(waxlabs_store::store& st, const char* data, size_t size) {
+    reader rd{data, data + size};
+    if (rd.varuint32() != GET_BLOCKS_RESULT_V0) {
+        throw std::runtime_error("unexpected state history result");
+    }
+
+    block_position head, last_irreversible, this_block, prev_block;
+    read(rd, head);
+    read(rd, last_irreversible);
+    bool has_block = read_flag(rd);
+    if (has_block) read(rd, this_block);
+    if (read_flag(rd)) read(rd, prev_block);
+
+    //block and traces are not requested, skip them when a node sends them anyway
+    std::string_view skipped, deltas;
+    if (read_flag(rd)) read(rd, skipped);
+    if (read_flag(rd)) read(rd, skipped);
+    bool has_deltas = read_flag(rd);
+    if (has_deltas) read(rd, deltas);
+    if (!rd.ok) {
+        throw std::runtime_error("truncated state history result");
+    }
+    if (!has_block) {
+        return 0;
+    }
+
+    auto lock = st.write_lock();
+    st.begin_block();
+
+    reader drd{deltas.data(), deltas.data() + deltas.size()};
+    uint32_t delta_count = has_deltas ? drd.varuint32() : 0;
+    for (uint32_t i = 0; i < delta_count && drd.ok; i++) {
+        if (drd.varuint32() != TABLE_DELTA_V0) {
+            throw std::runtime_error("unsupported table delta version");
+        }
+        std::string_view delta_name;
+        read(drd, delta_name);
+        bool contract_rows = delta_name == "contract_row";
+
+        uint32_t row_count = drd.varuint32();
+        for (uint32_t r = 0; r < row_count && drd.ok; r++) {
+            bool present = read_flag(drd);
+            std::string_view row;
+            read(drd, row);
+            if (!contract_rows) continue;
+
+            reader rrd{row.data(), row.data() + row.size()};
+            if (rrd.varuint32() != CONTRACT_ROW_V0) {
+                throw std::runtime_error("unsupported contract row version");
+            }
+            uint64_t code, scope, table, primary_key, payer;
+            std::string_view value;
+            read(rrd, code);
+            read(rrd, scope);
+            read(rrd, table);
+            read(rrd, primary_key);
+            read(rrd, payer);
+            read(rrd, value);
+            if (!rrd.ok) {
+                throw std::runtime_error("truncated contract row");
+            }
+            if (code == st.state().contract) {
+                st.apply(table, scope, primary_key, present, value.data(), value.size());
+            }
+        }
+    }
+    if (!drd.ok) {
+        throw std::runtime_error("truncated table deltas");
+    }
+
+    st.commit_block(this_block.block_num);
+    return this_block.block_num;
+}
+
+//======================== commands ========================
+
+size_t store_size() {
+    const char* mb = std::getenv("LABSINDEX_MB");
+    return size_t(mb ? std::strtoull(mb, nullptr, 10) : 1024) << 20;
+}
+
+//fixture records: uint32 little endian size, then the result message as received
+void append_fixture(std::ofstream& out, const char* data, uint32_t size) {
+    out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    out.write(data, size);
+}
+
+int sync(const std::string& path, const std::string& host, const std::string& port, name contract, const char* fixture) {
+    waxlabs_store::store st(path, store_size());
+    st.set_contract(contract.value);
+
+    std::ofstream record;
+    if (fixture) {
+        record.open(fixture, std::ios::binary | std::ios::app);
+    }
+
+    asio::io_context ioc;
+    tcp::resolver resolver(ioc);
+    beast::websocket::stream<tcp::socket> ws(ioc);
+    asio::connect(ws.next_layer(), resolver.resolve(host, port));
+    ws.handshake(host, "/");
+    ws.read_message_max(0);
+
+    //the first message is the state history ABI, the layout is fixed here
+    beast::flat_buffer buffer;
+    ws.read(buffer);
+    buffer.consume(buffer.size());
+
+    //get_blocks_request_v0, irreversible deltas only
+    std::string request;
+    {
+        auto put = [&](const void* value, size_t size) { request.append(static_cast<const char*>(value), size); };
+        uint8_t variant = GET_BLOCKS_REQUEST_V0;
+        uint32_t start_block = st.state().last_block + 1;
+        uint32_t end_block = 0xFFFFFFFF;
+        uint32_t in_flight = MAX_MESSAGES_IN_FLIGHT;
+        uint8_t no_positions = 0, irreversible_only = 1, fetch_block = 0, fetch_traces = 0, fetch_deltas = 1;
+        put(&variant, 1);
+        put(&start_block, 4);
+        put(&end_block, 4);
+        put(&in_flight, 4);
+        put(&no_positions, 1);
+        put(&irreversible_only, 1);
+        put(&fetch_block, 1);
+        put(&fetch_traces, 1);
+        put(&fetch_deltas, 1);
+    }
+    ws.binary(true);
+    ws.write(asio::buffer(request));
+    std::cerr << ">>> Syncing " << contract.to_string() << " from block " << st.state().last_block + 1 << std::endl;
+
+    //get_blocks_ack_request_v0 for one message
+    char ack[5] = { char(GET_BLOCKS_ACK_REQUEST_V0), 1, 0, 0, 0 };
+
+    uint32_t applied = 0;
+    auto started = std::chrono::steady_clock::now();
+    while (true) {
+        ws.read(buffer);
+        auto data = static_cast<const char*>(buffer.data().data());
+        uint32_t size = uint32_t(buffer.size());
+        if (record.is_open()) {
+            append_fixture(record, data, size);
+        }
+        uint32_t block_num = apply_result(st, data, size);
+        buffer.consume(buffer.size());
+        ws.write(asio::buffer(ack, sizeof(ack)));
+
+        if (block_num && ++applied % 10000 == 0) {
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+            std::cerr << "block " << block_num << ", " << applied / seconds << " blocks/s, "
+                << st.proposals().size() << " proposals, " << st.rows().size() << " other rows" << std::endl;
+        }
+    }
+}
+
+int replay(const std::string& path, const char* fixture, name contract) {
+    waxlabs_store::store st(path, store_size());
+    st.set_contract(contract.value);
+
+    std::ifstream in(fixture, std::ios::binary);
+    if (!in) {
+        std::cerr << "cannot open " << fixture << std::endl;
+        return 1;
+    }
+
+    std::string message;
+    uint32_t size = 0, applied = 0, skipped = 0;
+    auto started = std::chrono::steady_clock::now();
+    while (in.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+        message.resize(size);
+        if (!in.read(message.data(), size)) {
+            std::cerr << "truncated fixture" << std::endl;
+            return 1;
+        }
+        //peek this_block so messages already in the store are skipped, like a resumed sync
+        reader rd{message.data(), message.data() + message.size()};
+        rd.varuint32();
+        block_position head, last_irreversible, this_block;
+        read(rd, head);
+        read(rd, last_irreversible);
+        if (read_flag(rd)) read(rd, this_block);
+        if (this_block.block_num != 0 && this_block.block_num <= st.state().last_block) {
+            skipped++;
+            continue;
+        }
+        if (apply_result(st, message.data(), message.size())) applied++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    std::cout << "applied " << applied << " blocks (" << skipped << " already in store) in " << seconds << " s, last block "
+        << st.state().last_block << ", " << st.proposals().size() << " proposals, " << st.rows().size() << " other rows" << std::endl;
+    return 0;
+}
+
+void print_proposal(const waxlabs_store::proposal_row& row) {
+    waxlabs_codec::proposal prop;
+    waxlabs_codec::decode(row.data.data(), row.data.size(), prop);
+    std::cout << prop.proposal_id << "\t" << name(prop.proposer).to_string() << "\tstatus " << int(prop.status)
+        << "\tcategory " << int(prop.category) << "\trequested " << prop.total_requested_funds.amount
+        << "\tupdated " << prop.update_ts << "\t" << prop.title << std::endl;
+}
+
+int get(const std::string& path, uint64_t proposal_id) {
+    waxlabs_store::store st(path, store_size());
+    auto lock = st.read_lock();
+
+    auto started = std::chrono::steady_clock::now();
+    auto& by_pk = st.proposals().get<waxlabs_store::by_id>();
+    auto itr = by_pk.find(proposal_id);
+    waxlabs_codec::proposal prop;
+    bool found = itr != by_pk.end() && waxlabs_codec::decode(itr->data.data(), itr->data.size(), prop);
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+
+    if (!found) {
+        std::cerr << "proposal not found" << std::endl;
+        return 1;
+    }
+    print_proposal(*itr);
+    std::cerr << "found and decoded in " << elapsed << " us" << std::endl;
+    return 0;
+}
+
+//uint128 bounds, decimal or 0x hex
+waxlabs_keys::key128_t parse_key(const std::string& str) {
+    waxlabs_keys::key128_t value = 0;
+    bool hex = str.rfind("0x", 0) == 0;
+    for (size_t i = hex ? 2 : 0; i < str.size(); i++) {
+        char c = str[i];
+        int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+        if (digit < 0 || digit >= (hex ? 16 : 10)) {
+            throw std::runtime_error("invalid key " + str);
+        }
+        value = value * (hex ? 16 : 10) + digit;
+    }
+    return value;
+}
+
+template<typename Index, typename Key>
+int walk_index(const Index& index, Key lower_bound, Key upper_bound, uint32_t limit) {
+    auto started = std::chrono::steady_clock::now();
+    uint32_t count = 0;
+    for (auto itr = index.lower_bound(lower_bound); itr != index.end() && count < limit; ++itr, ++count) {
+        if (index.key_extractor()(*itr) > upper_bound) break;
+        print_proposal(*itr);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+    std::cerr << count << " proposals in " << elapsed << " us" << std::endl;
+    return 0;
+}
+
+int walk(const std::string& path, const std::string& index, waxlabs_keys::key128_t lower_bound,
+    waxlabs_keys::key128_t upper_bound, uint32_t limit) {
+    waxlabs_store::store st(path, store_size());
+    auto lock = st.read_lock();
+    auto& props = st.proposals();
+
+    //64-bit indices reject bounds above 2^64 - 1, like getprops
+    if (index != "byproposer" && index != "byreviewer" && (lower_bound >> 64 || upper_bound >> 64)) {
+        std::cerr << "bounds out of range for " << index << std::endl;
+        return 1;
+    }
+    if (index == "bystatcat") return walk_index(props.get<waxlabs_store::bystatcat>(), uint64_t(lower_bound), uint64_t(upper_bound), limit);
+    if (index == "bycatstat") return walk_index(props.get<waxlabs_store::bycatstat>(), uint64_t(lower_bound), uint64_t(upper_bound), limit);
+    if (index == "byproposer") return walk_index(props.get<waxlabs_store::byproposer>(), lower_bound, upper_bound, limit);
+    if (index == "byreviewer") return walk_index(props.get<waxlabs_store::byreviewer>(), lower_bound, upper_bound, limit);
+    if (index == "byupdatets") return walk_index(props.get<waxlabs_store::byupdatets>(), uint64_t(lower_bound), uint64_t(upper_bound), limit);
+
+    std::cerr << "index must be bystatcat, bycatstat, byproposer, byreviewer or byupdatets" << std::endl;
+    return 1;
+}
+
+int info(const std::string& path) {
+    waxlabs_store::store st(path, store_size());
+    auto lock = st.read_lock();
+
+    std::map<uint64_t, size_t> tables;
+    for (auto& row : st.rows()) tables[row.table]++;
+
+    std::cout << "contract\t" << name(st.state().contract).to_string() << std::endl;
+    std::cout << "last block\t" << st.state().last_block << std::endl;
+    std::cout << "free bytes\t" << st.free_memory() << std::endl;
+    std::cout << "proposals\t" << st.proposals().size() << std::endl;
+    for (auto& table : tables) {
+        std::cout << name(table.first).to_string() << "\t" << table.second << std::endl;
+    }
+    return 0;
+}
+
+//answers keyword queries from stdin while another process may keep syncing the store
+//a query line is words plus optional status:<n>, category:<n> and limit:<n> terms
+//the index catches up with the changes feed before every query
+int run_search(const std::string& path) {
+    waxlabs_store::store st(path, store_size());
+    waxlabs_search::index idx;
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        waxlabs_search::filter flt;
+        size_t limit = 20;
+        std::string text, word;
+        std::istringstream words(line);
+        while (words >> word) {
+            if (word.rfind("status:", 0) == 0) {
+                flt.status = uint8_t(std::stoul(word.substr(7)));
+            } else if (word.rfind("category:", 0) == 0) {
+                flt.category = uint8_t(std::stoul(word.substr(9)));
+            } else if (word.rfind("limit:", 0) == 0) {
+                limit = std::stoul(word.substr(6));
+            } else {
+                text += word + " ";
+            }
+        }
+
+        auto lock = st.read_lock();
+        auto started = std::chrono::steady_clock::now();
+        size_t indexed = idx.refresh(st);
+        auto refreshed = std::chrono::steady_clock::now();
+        auto hits = idx.query(text, flt, limit);
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - refreshed).count();
+        double refresh_elapsed = std::chrono::duration<double, std::micro>(refreshed - started).count();
+
+        auto& by_pk = st.proposals().get<waxlabs_store::by_id>();
+        for (const auto& hit : hits) {
+            std::cout << hit.score << "\t";
+            print_proposal(*by_pk.find(hit.proposal_id));
+        }
+        std::cerr << hits.size() << " hits in " << elapsed << " us, " << indexed << " proposals indexed in "
+            << refresh_elapsed << " us, " << idx.documents() << " documents, " << idx.terms() << " terms" << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string cmd = argc > 1 ? argv[1] : "";
+    try {
+        if (cmd == "sync" && (argc == 6 || argc == 7)) {
+            return sync(argv[2], argv[3], argv[4], name(argv[5]), argc == 7 ? argv[6] : nullptr);
+        } else if (cmd == "replay" && argc == 5) {
+            return replay(argv[2], argv[3], name(argv[4]));
+        } else if (cmd == "get" && argc == 4) {
+            return get(argv[2], std::strtoull(argv[3], nullptr, 10));
+        } else if (cmd == "walk" && (argc == 6 || argc == 7)) {
+            return walk(argv[2], argv[3], parse_key(argv[4]), parse_key(argv[5]), argc == 7 ? std::strtoul(argv[6], nullptr, 10) : 20);
+        } else if (cmd == "info" && argc == 3) {
+            return info(argv[2]);
+        } else if (cmd == "search" && argc == 3) {
+            return run_search(argv[2]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "usage:" << std::endl
+        << "  labsindex sync <store> <host> <port> <contract> [fixture]" << std::endl
+        << "  labsindex replay <store> <fixture> <contract>" << std::endl
+        << "  labsindex get <store> <proposal_id>" << std::endl
+        << "  labsindex walk <store> <index> <lower_bound> <upper_bound> [limit]" << std::endl
+        << "  labsindex info <store>" << std::endl
+        << "  labsindex search <store>" << std::endl;
+    return 1;
+}
@@ -0,0 +1,405 @@
+// labsload: native WAX Labs load generator.
+//
+// Runs the full proposal pipeline for users 1 to users, one action per
+// transaction, packed with waxlabs_client and signed and sent with
+// waxlabs_push, so no cleos or abi_json_to_bin call is on the hot path:
+//
+//   newprofile, deposit, draftprop, newdeliv, submitprop, setreviewer, skipvoting,
+//   submitreport, reviewdeliv, claimfunds, withdraw
+//
+// User n is the account lgu<n> with digits as letters (lgub, lgubc, ...),
+// loadgen.sh creates and funds them. admin signs setreviewer, skipvoting and
+// reviewdeliv. A failed action ends the pipeline of its user.
+//
+//   labsload <nodeos_url> <keosd_url> <contract> <admin> <admin_pubkey> <user_pubkey> <users> <rows_log> [connections] [tps]
+//
+// Every connection runs one user pipeline at a time (default 8 connections).
+// With a target tps (default 0, as fast as the connections can), every
+// transaction takes the next send slot from a counter shared by all
+// connections, slot n is sent at start + n / tps. A slot sent more than
+// 100 ms late is counted as behind schedule.
+//
+// Prints a markdown report: accepted TPS, per-action CPU distribution from
+// the transaction receipts, busiest blocks and the rows written most often,
+// read from the changes feed after the run. With the trace build deployed,
+// every shared row access printed to the action console is written to
+// rows_log as: user action R|W table scope key (read by conflicts.sh).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "waxlabs_push.hpp"
+
+using namespace waxlabs_client;
+using namespace waxlabs_push;
+
+using clock_type = std::chrono::steady_clock;
+
+//WAX each user deposits, the deliverable requests and withdraws it again after the claim
+const asset DEPOSIT = wax(1200'00000000);
+const asset REQUESTED = wax(1000'00000000);
+
+//a paced transaction sent later than this is behind schedule
+constexpr double BEHIND_SECONDS = 0.1;
+
+//transactions are packed against a reference block at most this old
+constexpr double REFRESH_SECONDS = 60;
+
+constexpr size_t TOP_BLOCKS = 10;
+constexpr size_t TOP_ROWS = 10;
+constexpr uint32_t CHANGES_PAGE = 1000;
+
+//report order of the pipeline actions
+const char* const PIPELINE[] = { "newprofile", "deposit", "draftprop", "newdeliv", "submitprop", "setreviewer",
+    "skipvoting", "submitreport", "reviewdeliv", "claimfunds", "withdraw" };
+
+struct sent {
+    std::string action;
+    bool ok = false;
+    uint64_t cpu_us = 0;
+    uint64_t block_num = 0;
+    std::string error;
+};
+
+//maps a user index to a valid account name, digits become letters
+name user_name(size_t n) {
+    std::string user = "lgu" + std::to_string(n);
+    for (size_t i = 3; i < user.size(); i++) user[i] = char('a' + (user[i] - '0'));
+    return name(user);
+}
+
+//shared send schedule, slot n is due at start + n / tps
+class pacer {
+    public:
+
+    pacer(clock_type::time_point start, double tps) : _start(start), _tps(tps) {}
+
+    //waits for the next slot, returns how many seconds late it was taken, negative when early
+    double wait() {
+        if (_tps <= 0) return 0;
+        uint64_t slot = _next++;
+        auto due = _start + std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(slot / _tps));
+        double late = std::chrono::duration<double>(clock_type::now() - due).count();
+        if (late < 0) std::this_thread::sleep_until(due);
+        return late;
+    }
+
+    bool paced() const { return _tps > 0; }
+
+    private:
+
+    clock_type::time_point _start;
+    double _tps;
+    std::atomic<uint64_t> _next{0};
+};
+
+//one connection pair running user pipelines, results are merged after the run
+class worker {
+    public:
+
+    worker(const endpoint& nodeos, const endpoint& keosd, pacer& pace)
+        : _nodeos(nodeos), _wallet(keosd), _chain(nodeos), _pace(pace) {}
+
+    void run_user(size_t n, name contract, name admin, const std::string& admin_pubkey, const std::string& user_pubkey) {
+        name user = user_name(n);
+        std::string label = std::to_string(n);
+        std::string response;
+        auto as_user = [&](const char* act, const auto& args, name code) {
+            return push(act, make_action(code, user, args), user, user_pubkey, response);
+        };
+        auto as_admin = [&](const char* act, const auto& args) {
+            return push(act, make_action(contract, admin, args), user, admin_pubkey, response);
+        };
+
+        if (!as_user("newprofile", newprofile{user, "Load " + label, "US", "load generator", "", "", "", ""}, contract)) return;
+        if (!as_user("deposit", transfer{user, contract, DEPOSIT, ""}, name("eosio.token"))) return;
+        if (!as_user("draftprop", draftprop{"Load " + label, "load generator proposal", "# Load " + label, user,
+            "", 30, name("other"), "road map"}, contract)) return;
+
+        //proposal_result starts with the proposal_id
+        std::string result = unhex(json_string(response, "return_value_hex_data"));
+        if (result.size() < sizeof(uint64_t)) {
+            _results.push_back(sent{"newdeliv", false, 0, 0, "no proposal_result in the draftprop response"});
+            return;
+        }
+        uint64_t id;
+        std::memcpy(&id, result.data(), sizeof(id));
+
+        if (!as_user("newdeliv", newdeliv{id, 1, REQUESTED, user, "deliverable", 10}, contract)) return;
+        if (!as_user("submitprop", submitprop{id}, contract)) return;
+        if (!as_admin("setreviewer", setreviewer{id, 0, admin})) return;
+        if (!as_admin("skipvoting", skipvoting{id, "load"})) return;
+        if (!as_user("submitreport", submitreport{id, 1, "done"}, contract)) return;
+        if (!as_admin("reviewdeliv", reviewdeliv{id, 1, true, "ok"})) return;
+        if (!as_user("claimfunds", claimfunds{id, 1}, contract)) return;
+        as_user("withdraw", withdraw{user, REQUESTED}, contract);
+    }
+
+    const std::vector<sent>& results() const { return _results; }
+    const std::vector<double>& lags() const { return _lags; }
+    const std::vector<std::string>& row_accesses() const { return _rows; }
+
+    private:
+
+    //packs, signs and sends one action, records its receipt and console row accesses
+    bool push(const char* label, const action& act, name user, const std::string& pubkey, std::string& response) {
+        sent res;
+        res.action = label;
+        try {
+            if (_state_time == clock_type::time_point() ||
+                std::chrono::duration<double>(clock_type::now() - _state_time).count() > REFRESH_SECONDS) {
+                _state = get_chain_state(_nodeos);
+                _state_time = clock_type::now();
+            }
+            std::string packed = pack_transaction(_state.header, &act, 1);
+            std::string signature = sign(_wallet, _state, pubkey, packed);
+            if (_pace.paced()) _lags.push_back(_pace.wait());
+            unsigned status = send(_chain, signature, packed, response);
+            res.ok = status >= 200 && status < 300;
+            if (res.ok) {
+                size_t processed = response.find("\"processed\"");
+                res.cpu_us = json_number(response, "cpu_usage_us", processed);
+                res.block_num = json_number(response, "block_num", processed);
+                for (const auto& console : json_strings(response, "console")) {
+                    std::istringstream lines(console);
+                    std::string line, access, table, scope, key, extra;
+                    while (std::getline(lines, line)) {
+                        std::istringstream fields(line);
+                        if (fields >> access >> table >> scope >> key && !(fields >> extra)) {
+                            _rows.push_back(user.to_string() + " " + label + " " + line);
+                        }
+                    }
+                }
+            } else {
+                res.error = error_message(response);
+            }
+        } catch (const std::exception& e) {
+            res.error = e.what();
+        }
+        _results.push_back(res);
+        return res.ok;
+    }
+
+    endpoint _nodeos;
+    connection _wallet;
+    connection _chain;
+    pacer& _pace;
+    chain_state _state;
+    clock_type::time_point _state_time;
+    std::vector<sent> _results;
+    std::vector<double> _lags;
+    std::vector<std::string> _rows;
+};
+
+//======================== changes feed ========================
+
+//packed rows of one get_table_rows page of the changes feed, json off
+std::vector<waxlabs_codec::change> changes_page(connection& chain, name contract, const std::string& bounds, bool& more, std::string& next_key) {
+    std::string response;
+    std::string body = "{\"code\":\"" + contract.to_string() + "\",\"scope\":\"" + contract.to_string() +
+        "\",\"table\":\"changes\",\"json\":false," + bounds + "}";
+    if (chain.post("/v1/chain/get_table_rows", body, response) != 200) {
+        throw std::runtime_error("get_table_rows changes: " + error_message(response));
+    }
+
+    std::vector<waxlabs_codec::change> rows;
+    size_t start = response.find("\"rows\":[");
+    if (start == std::string::npos) {
+        throw std::runtime_error("unexpected get_table_rows response: " + response.substr(0, 200));
+    }
+    size_t end = response.find(']', start);
+    for (size_t pos = start + 8; pos < end; ) {
+        size_t open = response.find('"', pos);
+        if (open >= end) break;
+        size_t close = response.find('"', open + 1);
+        std::string packed = unhex(response.substr(open + 1, close - open - 1));
+        waxlabs_codec::change row;
+        if (!waxlabs_codec::decode(packed.data(), packed.size(), row)) {
+            throw std::runtime_error("changes row does not match the codec layout");
+        }
+        rows.push_back(row);
+        pos = close + 1;
+    }
+    more = response.find("\"more\":true") != std::string::npos;
+    next_key = json_string(response, "next_key");
+    return rows;
+}
+
+//seq the next change will get
+uint64_t next_change_seq(connection& chain, name contract) {
+    bool more;
+    std::string next_key;
+    auto rows = changes_page(chain, contract, "\"limit\":1,\"reverse\":true", more, next_key);
+    return rows.empty() ? 0 : rows[0].seq + 1;
+}
+
+//======================== report ========================
+
+//nearest rank percentile of sorted values
+uint64_t percentile(const std::vector<uint64_t>& sorted, size_t pct) {
+    return sorted[std::max<size_t>(1, (sorted.size() * pct + 99) / 100) - 1];
+}
+
+void print_actions(const std::vector<sent>& results) {
+    std::printf("| action | ok | failed | cpu p50 us | cpu p95 us | cpu max us |\n");
+    std::printf("|---|---|---|---|---|---|\n");
+    std::map<std::string, std::string> first_errors;
+    for (const char* act : PIPELINE) {
+        std::vector<uint64_t> cpus;
+        size_t failed = 0;
+        for (const auto& res : results) {
+            if (res.action != act) continue;
+            if (res.ok) {
+                cpus.push_back(res.cpu_us);
+            } else if (failed++ == 0) {
+                first_errors[act] = res.error;
+            }
+        }
+        if (cpus.empty()) {
+            std::printf("| %s | 0 | %zu | n/a | n/a | n/a |\n", act, failed);
+            continue;
+        }
+        std::sort(cpus.begin(), cpus.end());
+        std::printf("| %s | %zu | %zu | %llu | %llu | %llu |\n", act, cpus.size(), failed, (unsigned long long)percentile(cpus, 50),
+            (unsigned long long)percentile(cpus, 95), (unsigned long long)cpus.back());
+    }
+    for (const auto& [act, error] : first_errors) {
+        std::printf("\nfirst %s error: %s\n", act.c_str(), error.c_str());
+    }
+}
+
+void print_blocks(const std::vector<sent>& results) {
+    //block -> transactions, cpu
+    std::map<uint64_t, std::pair<uint64_t, uint64_t>> blocks;
+    for (const auto& res : results) {
+        if (!res.ok) continue;
+        blocks[res.block_num].first++;
+        blocks[res.block_num].second += res.cpu_us;
+    }
+    std::vector<std::pair<uint64_t, std::pair<uint64_t, uint64_t>>> busiest(blocks.begin(), blocks.end());
+    std::sort(busiest.begin(), busiest.end(), [](const auto& a, const auto& b) { return a.second.second > b.second.second; });
+    busiest.resize(std::min(busiest.size(), TOP_BLOCKS));
+
+    std::printf("\n## Busiest blocks\n\n");
+    std::printf("| block | transactions | cpu us |\n");
+    std::printf("|---|---|---|\n");
+    for (const auto& [block, load] : busiest) {
+        std::printf("| %llu | %llu | %llu |\n", (unsigned long long)block, (unsigned long long)load.first, (unsigned long long)load.second);
+    }
+}
+
+//rows written most often since start_seq, read page by page from the changes feed
+void print_hot_rows(connection& chain, name contract, uint64_t start_seq) {
+    std::map<std::tuple<uint64_t, uint64_t, uint64_t>, uint64_t> writes;
+    uint64_t first_seq = start_seq;
+    bool first = true;
+    bool more = true;
+    std::string lower = std::to_string(start_seq);
+    while (more) {
+        auto rows = changes_page(chain, contract, "\"lower_bound\":\"" + lower + "\",\"limit\":" + std::to_string(CHANGES_PAGE), more, lower);
+        for (const auto& row : rows) {
+            if (first) first_seq = row.seq;
+            first = false;
+            writes[{row.table_name, row.scope, row.key}]++;
+        }
+    }
+    std::vector<std::pair<std::tuple<uint64_t, uint64_t, uint64_t>, uint64_t>> hottest(writes.begin(), writes.end());
+    std::sort(hottest.begin(), hottest.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    hottest.resize(std::min(hottest.size(), TOP_ROWS));
+
+    std::printf("\n## Hottest rows\n\n");
+    if (first_seq > start_seq) {
+        std::printf("The feed keeps only the last CHANGE_RETENTION entries, counts start at seq %llu instead of %llu.\n\n",
+            (unsigned long long)first_seq, (unsigned long long)start_seq);
+    }
+    std::printf("| table | scope | key | writes |\n");
+    std::printf("|---|---|---|---|\n");
+    for (const auto& [row, count] : hottest) {
+        std::printf("| %s | %llu | %llu | %llu |\n", name(std::get<0>(row)).to_string().c_str(),
+            (unsigned long long)std::get<1>(row), (unsigned long long)std::get<2>(row), (unsigned long long)count);
+    }
+}
+
+int load(const endpoint& nodeos, const endpoint& keosd, name contract, name admin, const std::string& admin_pubkey,
+    const std::string& user_pubkey, size_t users, const std::string& rows_log, size_t connections, double tps) {
+    connection chain(nodeos);
+    uint64_t start_seq = next_change_seq(chain, contract);
+
+    auto started = clock_type::now();
+    pacer pace(started, tps);
+    std::vector<std::unique_ptr<worker>> workers;
+    for (size_t w = 0; w < connections; w++) {
+        workers.emplace_back(new worker(nodeos, keosd, pace));
+    }
+
+    //every connection takes the next user and runs its whole pipeline
+    std::atomic<size_t> next{1};
+    std::vector<std::thread> threads;
+    for (auto& wk : workers) {
+        threads.emplace_back([&, wk = wk.get()]() {
+            for (size_t n = next++; n <= users; n = next++) {
+                wk->run_user(n, contract, admin, admin_pubkey, user_pubkey);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(clock_type::now() - started).count();
+
+    std::vector<sent> results;
+    std::vector<double> lags;
+    std::ofstream rows(rows_log, std::ios::trunc);
+    for (const auto& wk : workers) {
+        results.insert(results.end(), wk->results().begin(), wk->results().end());
+        lags.insert(lags.end(), wk->lags().begin(), wk->lags().end());
+        for (const auto& line : wk->row_accesses()) rows << line << "\n";
+    }
+    size_t ok = std::count_if(results.begin(), results.end(), [](const sent& res) { return res.ok; });
+
+    std::printf("# %s load report\n\n", contract.to_string().c_str());
+    std::printf("%zu users, %zu connections, %zu accepted, %zu failed in %.3fs: %.1f TPS\n", users, connections,
+        ok, results.size() - ok, elapsed, ok / elapsed);
+    if (pace.paced()) {
+        size_t behind = std::count_if(lags.begin(), lags.end(), [](double late) { return late > BEHIND_SECONDS; });
+        double worst = lags.empty() ? 0 : *std::max_element(lags.begin(), lags.end());
+        std::printf("\ntarget %.1f TPS, %zu of %zu transactions sent more than 100 ms behind schedule, worst %.3fs\n",
+            tps, behind, lags.size(), worst);
+    }
+    std::printf("\n");
+    print_actions(results);
+    print_blocks(results);
+    print_hot_rows(chain, contract, start_seq);
+    return ok == results.size() ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 9 && argc <= 11) {
+        try {
+            size_t users = std::strtoull(argv[7], nullptr, 10);
+            size_t connections = argc > 9 ? std::strtoull(argv[9], nullptr, 10) : 8;
+            double tps = argc > 10 ? std::strtod(argv[10], nullptr) : 0;
+            if (users > 0 && connections > 0 && tps >= 0) {
+                return load(parse_url(argv[1]), parse_url(argv[2]), name(argv[3]), name(argv[4]), argv[5], argv[6],
+                    users, argv[8], connections, tps);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cerr << "usage: labsload <nodeos_url> <keosd_url> <contract> <admin> <admin_pubkey> <user_pubkey> <users> <rows_log> [connections] [tps]" << std::endl;
+    return 1;
+}
@@ -0,0 +1,157 @@
+// labspush: pipelined WAX Labs transaction push with the native client.
+//
+// Packs deposit transfers or contract actions with waxlabs_client, with no
+// abi_json_to_bin call. Then the packed transactions are signed through keosd
+// and sent to nodeos over several keep-alive connections at once. Each
+// connection signs and sends its next transaction while the others wait on
+// theirs, so the push rate is not bound by one round trip.
+//
+//   labspush <nodeos_url> <keosd_url> <contract> <account> <pubkey> <workload> <count> [batch] [connections]
+//
+// Pushes count actions of workload, batch actions per transaction (default 1)
+// over connections connections (default 8). Workloads:
+//
+//   transfer              0.00000001 WAX from account to contract with a unique
+//                         memo, so every transfer is an account deposit
+//   draftprop:<category>  a draftprop of account in category, paid from a draft
+//                         slot or the account balance, so account needs a profile
+//                         and DRAFT_COST per action
+//
+// keosd must be unlocked and hold the key of pubkey for account@active. Only
+// http:// urls are supported.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "waxlabs_push.hpp"
+
+using namespace waxlabs_client;
+using namespace waxlabs_push;
+
+struct push_result {
+    bool accepted = false;
+    double sign_ms = 0;
+    double send_ms = 0;
+    std::string error;
+};
+
+double percentile(std::vector<double> values, double pct) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, size_t(pct / 100 * values.size()))];
+}
+
+//action i of workload, see the usage above
+action make_workload_action(const std::string& workload, name contract, name account, size_t i) {
+    std::string n = std::to_string(i);
+    if (workload == "transfer") {
+        return make_action(name("eosio.token"), account, transfer{account, contract, wax(1), "labspush " + n});
+    }
+    if (workload.rfind("draftprop:", 0) == 0) {
+        return make_action(contract, account, draftprop{"labspush " + n, "labspush load test proposal " + n,
+            "# labspush " + n, account, "", 30, name(workload.substr(10)), "labspush road map " + n});
+    }
+    throw std::invalid_argument("unknown workload: " + workload);
+}
+
+int push(const endpoint& nodeos, const endpoint& keosd, name contract, name account, const std::string& pubkey,
+    const std::string& workload, size_t count, size_t batch, size_t connections) {
+    chain_state state = get_chain_state(nodeos);
+
+    //pack every transaction up front, native packing needs no api calls
+    auto pack_start = std::chrono::steady_clock::now();
+    std::vector<action> acts;
+    acts.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        acts.push_back(make_workload_action(workload, contract, account, i));
+    }
+    std::vector<std::string> packed = pack_batches(state.header, acts, batch);
+    double pack_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pack_start).count();
+
+    //every connection takes the next unsent transaction, signs it and sends it
+    std::vector<push_result> results(packed.size());
+    std::atomic<size_t> next{0};
+    auto started = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < connections; w++) {
+        workers.emplace_back([&]() {
+            connection wallet(keosd);
+            connection chain(nodeos);
+            for (size_t i = next++; i < packed.size(); i = next++) {
+                push_result& res = results[i];
+                try {
+                    auto sign_start = std::chrono::steady_clock::now();
+                    std::string signature = sign(wallet, state, pubkey, packed[i]);
+                    auto send_start = std::chrono::steady_clock::now();
+                    std::string response;
+                    unsigned status = send(chain, signature, packed[i], response);
+                    auto done = std::chrono::steady_clock::now();
+                    res.sign_ms = std::chrono::duration<double, std::milli>(send_start - sign_start).count();
+                    res.send_ms = std::chrono::duration<double, std::milli>(done - send_start).count();
+                    res.accepted = status >= 200 && status < 300;
+                    if (!res.accepted) res.error = error_message(response);
+                } catch (const std::exception& e) {
+                    res.error = e.what();
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    size_t accepted = 0;
+    std::vector<double> sign_ms, send_ms;
+    std::string first_error;
+    for (const auto& res : results) {
+        if (res.accepted) {
+            accepted++;
+            sign_ms.push_back(res.sign_ms);
+            send_ms.push_back(res.send_ms);
+        } else if (first_error.empty()) {
+            first_error = res.error;
+        }
+    }
+
+    std::printf("%s: %zu actions in %zu transactions of up to %zu, %zu connections\n\n", workload.c_str(), count, packed.size(), batch, connections);
+    std::printf("| Measure | Value |\n");
+    std::printf("|---|---|\n");
+    std::printf("| native packing | %.2f ms total, %.2f us/transaction |\n", pack_ms, pack_ms * 1000 / packed.size());
+    std::printf("| accepted transactions | %zu |\n", accepted);
+    std::printf("| failed transactions | %zu |\n", packed.size() - accepted);
+    std::printf("| push time | %.3f s |\n", elapsed);
+    std::printf("| accepted TPS | %.1f |\n", accepted / elapsed);
+    std::printf("| accepted actions/s | %.1f |\n", accepted * double(batch) / elapsed);
+    std::printf("| sign_digest p50 / p99 | %.2f / %.2f ms |\n", percentile(sign_ms, 50), percentile(sign_ms, 99));
+    std::printf("| send_transaction p50 / p99 | %.2f / %.2f ms |\n", percentile(send_ms, 50), percentile(send_ms, 99));
+    if (!first_error.empty()) {
+        std::printf("\nfirst error: %s\n", first_error.c_str());
+    }
+    return accepted == packed.size() ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 8 && argc <= 10) {
+        try {
+            size_t count = std::strtoull(argv[7], nullptr, 10);
+            size_t batch = argc > 8 ? std::strtoull(argv[8], nullptr, 10) : 1;
+            size_t connections = argc > 9 ? std::strtoull(argv[9], nullptr, 10) : 8;
+            if (count > 0 && batch > 0 && connections > 0) {
+                return push(parse_url(argv[1]), parse_url(argv[2]), name(argv[3]), name(argv[4]), argv[5],
+                    argv[6], count, batch, connections);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    std::cerr << "usage: labspush <nodeos_url> <keosd_url> <contract> <account> <pubkey> { transfer | draftprop:<category> } <count> [batch] [connections]" << std::endl;
+    return 1;
+}
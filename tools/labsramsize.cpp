@@ -0,0 +1,111 @@
+// labsramsize: RAM saved by the compact row encoding.
+//
+// Reads every proposals, deliverables, accounts and stats row of a labsindex
+// store, the rows exactly as the contract stores them. Each row is encoded
+// with waxlabs_compact, read back through waxlabs_compact::view and packed
+// into the contract layout again. The tool fails when that round trip does
+// not give back the stored bytes, so the reported sizes are those of an
+// encoding that loses nothing.
+//
+//   labsramsize <store>
+//
+// Prints a markdown table of packed row bytes per table. The RAM billed per
+// row also includes a fixed 112 byte overhead that no encoding changes.
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "waxlabs_compact.hpp"
+#include "waxlabs_store.hpp"
+
+using waxlabs_codec::name;
+
+//RAM billed per row on top of the packed row
+constexpr uint64_t ROW_OVERHEAD = 112;
+
+struct table_size {
+    uint64_t rows = 0;
+    uint64_t current = 0;
+    uint64_t compact = 0;
+};
+
+size_t store_size() {
+    const char* mb = std::getenv("LABSINDEX_MB");
+    return size_t(mb ? std::strtoull(mb, nullptr, 10) : 1024) << 20;
+}
+
+//measures one packed row, throws when it does not survive the compact round trip
+template<typename Row>
+void measure(table_size& size, uint64_t table, uint64_t primary_key, const char* data, size_t length) {
+    Row row;
+    std::string compact;
+    waxlabs_compact::view<Row> back;
+    if (!waxlabs_codec::decode(data, length, row)) {
+        throw std::runtime_error(name(table).to_string() + " row " + std::to_string(primary_key) + " does not match the codec layout");
+    }
+    if (!waxlabs_compact::encode(row, compact)) {
+        throw std::runtime_error(name(table).to_string() + " row " + std::to_string(primary_key) + " holds an asset of another symbol");
+    }
+    if (!back.load(compact.data(), compact.size()) || back.packed() != std::string_view(data, length)) {
+        throw std::runtime_error(name(table).to_string() + " row " + std::to_string(primary_key) + " changed in the compact round trip");
+    }
+    size.rows++;
+    size.current += length;
+    size.compact += compact.size();
+}
+
+void print_size(const char* table, const table_size& size) {
+    if (size.rows == 0) {
+        std::printf("| %s | 0 | | | | |\n", table);
+        return;
+    }
+    double rows = double(size.rows);
+    uint64_t saved = size.current - size.compact;
+    std::printf("| %s | %llu | %.1f | %.1f | %.1f (%.0f%% of RAM) | %llu |\n", table, (unsigned long long)size.rows,
+        size.current / rows, size.compact / rows, saved / rows, 100.0 * saved / (size.current + ROW_OVERHEAD * size.rows),
+        (unsigned long long)saved);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        std::cerr << "usage: labsramsize <store>" << std::endl;
+        return 1;
+    }
+    try {
+        waxlabs_store::store st(argv[1], store_size());
+        auto lock = st.read_lock();
+
+        const uint64_t DELIVERABLES = name("deliverables").value;
+        const uint64_t ACCOUNTS = name("accounts").value;
+        const uint64_t STATS = name("stats").value;
+
+        table_size proposals, deliverables, accounts, stats;
+        for (const auto& row : st.proposals()) {
+            measure<waxlabs_codec::proposal>(proposals, waxlabs_store::PROPOSALS, row.proposal_id, row.data.data(), row.data.size());
+        }
+        for (const auto& row : st.rows()) {
+            if (row.table == DELIVERABLES) {
+                measure<waxlabs_codec::deliverable>(deliverables, row.table, row.primary_key, row.data.data(), row.data.size());
+            } else if (row.table == ACCOUNTS) {
+                measure<waxlabs_codec::account>(accounts, row.table, row.primary_key, row.data.data(), row.data.size());
+            } else if (row.table == STATS) {
+                measure<waxlabs_codec::stat>(stats, row.table, row.primary_key, row.data.data(), row.data.size());
+            }
+        }
+
+        std::printf("Packed row bytes of %s at block %u, excluding the fixed %llu byte RAM overhead per row.\n\n",
+            name(st.state().contract).to_string().c_str(), st.state().last_block, (unsigned long long)ROW_OVERHEAD);
+        std::printf("| table | rows | current avg | compact avg | saved per row | saved total |\n");
+        std::printf("|---|---|---|---|---|---|\n");
+        print_size("proposals", proposals);
+        print_size("deliverables", deliverables);
+        print_size("accounts", accounts);
+        print_size("stats", stats);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,65 @@
+// labsrender: cached HTML of WAX Labs proposal bodies and road maps.
+//
+// Serves the rendered, sanitized HTML of proposals from a labsindex store
+// while another process may keep syncing it. See waxlabs_render.hpp.
+//
+//   labsrender serve <store>
+//
+// Reads one proposal_id per line from stdin. Before each request the cache
+// follows the changes feed of the store, then the proposal's HTML is served
+// from memory, rendered only when its update_ts and input changed.
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "waxlabs_render.hpp"
+
+size_t store_size() {
+    const char* mb = std::getenv("LABSINDEX_MB");
+    return size_t(mb ? std::strtoull(mb, nullptr, 10) : 1024) << 20;
+}
+
+int serve(const std::string& path) {
+    waxlabs_store::store st(path, store_size());
+    waxlabs_render::cache cache;
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        uint64_t proposal_id = std::strtoull(line.c_str(), nullptr, 10);
+
+        auto lock = st.read_lock();
+        auto started = std::chrono::steady_clock::now();
+        size_t marked = cache.refresh(st);
+        uint64_t renders = cache.renders();
+        const waxlabs_render::rendered* html = cache.get(st, proposal_id);
+        auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count();
+
+        if (!html) {
+            std::cout << "<!-- proposal " << proposal_id << " not found -->" << std::endl;
+        } else {
+            std::cout << "<!-- proposal " << proposal_id << " update_ts " << html->update_ts << " -->" << std::endl;
+            std::cout << "<section class=\"body\">" << (html->body_too_long ? "<!-- body over MAX_BODY_LEN -->" : html->body_html) << "</section>" << std::endl;
+            std::cout << "<section class=\"road_map\">" << (html->road_map_too_long ? "<!-- road map over MAX_ROAD_MAP_LEN -->" : html->road_map_html) << "</section>" << std::endl;
+        }
+        std::cerr << "served in " << elapsed << " us, " << cache.renders() - renders << " renders, " << marked
+            << " entries invalidated, " << cache.entries() << " cached" << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string cmd = argc > 1 ? argv[1] : "";
+    try {
+        if (cmd == "serve" && argc == 3) {
+            return serve(argv[2]);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cerr << "usage: labsrender serve <store>" << std::endl;
+    return 1;
+}
@@ -0,0 +1,272 @@
+// labstest: tests of the off-chain headers.
+//
+// Runs without a node. Store-backed tests build a temporary waxlabs_store
+// from rows packed with waxlabs_codec, the way labsindex applies state
+// history deltas, and remove it when done.
+//
+//   labstest
+//
+// Prints each failed check and exits 1 when any check failed.
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include "waxlabs_render.hpp"
+
+using waxlabs_codec::name;
+
+static int failures = 0;
+static int checks = 0;
+
+//records a failed check with its line, like the contract's check() without aborting
+#define CHECK(cond) do { \
+        checks++; \
+        if (!(cond)) { \
+            failures++; \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": check failed: " #cond << std::endl; \
+        } \
+    } while (0)
+
+bool contains(const std::string& text, std::string_view part) {
+    return text.find(part) != std::string::npos;
+}
+
+//======================== sanitizer ========================
+
+void test_escape() {
+    std::string out;
+    waxlabs_render::escape_html("<a href=\"x\">&'</a>\x01\x7f\ttab", out);
+    CHECK(out == "&lt;a href=&quot;x&quot;&gt;&amp;&#39;&lt;/a&gt;\x7f\ttab");
+}
+
+void test_safe_url() {
+    CHECK(waxlabs_render::safe_url("https://labs.wax.io/proposals/1"));
+    CHECK(waxlabs_render::safe_url("HTTP://example.com"));
+    CHECK(waxlabs_render::safe_url("mailto:team@example.com"));
+    CHECK(waxlabs_render::safe_url("/proposals/1?tab=body#road-map"));
+    CHECK(waxlabs_render::safe_url("#deliverables"));
+    CHECK(!waxlabs_render::safe_url("javascript:alert(1)"));
+    CHECK(!waxlabs_render::safe_url("JaVaScRiPt:alert(1)"));
+    CHECK(!waxlabs_render::safe_url("data:text/html;base64,PHNjcmlwdD4="));
+    CHECK(!waxlabs_render::safe_url("vbscript:x"));
+    CHECK(!waxlabs_render::safe_url("java\tscript:alert(1)"));
+    CHECK(!waxlabs_render::safe_url("//evil.example.com"));
+    CHECK(!waxlabs_render::safe_url("https://a.com/x y"));
+    CHECK(!waxlabs_render::safe_url(""));
+}
+
+void test_no_raw_html() {
+    std::string html = waxlabs_render::render_markdown(
+        "<script>alert(1)</script>\n\n<img src=x onerror=alert(1)>\n\n"
+        "[click](javascript:alert(1))\n\n[q](https://a.com/\" onmouseover=\"alert(1))\n\n"
+        "`<b>` **<i>**\n\n```\n</code></pre><script>\n```");
+    CHECK(!contains(html, "<script"));
+    CHECK(!contains(html, "<img"));
+    CHECK(!contains(html, "<b>"));
+    CHECK(!contains(html, "<i>"));
+    CHECK(!contains(html, "javascript:"));
+    CHECK(!contains(html, "\" onmouseover"));
+    CHECK(contains(html, "&lt;script&gt;alert(1)&lt;/script&gt;"));
+    CHECK(contains(html, "<p>click)</p>"));
+    CHECK(contains(html, "<pre><code>&lt;/code&gt;&lt;/pre&gt;&lt;script&gt;\n</code></pre>"));
+}
+
+void test_markdown() {
+    std::string html = waxlabs_render::render_markdown(
+        "# Title\n"
+        "Some *em* and **strong** text\nwith `code` and a [link](https://wax.io).\n"
+        "\n"
+        "- one\n"
+        "- two\n"
+        "1. first\n"
+        "2. second\n"
+        "> quoted\n"
+        "####### not a heading");
+    CHECK(html ==
+        "<h1>Title</h1>\n"
+        "<p>Some <em>em</em> and <strong>strong</strong> text\nwith <code>code</code> and a "
+        "<a href=\"https://wax.io\" rel=\"nofollow noopener noreferrer\">link</a>.</p>\n"
+        "<ul>\n<li>one</li>\n<li>two</li>\n</ul>\n"
+        "<ol>\n<li>first</li>\n<li>second</li>\n</ol>\n"
+        "<blockquote>quoted</blockquote>\n"
+        "<p>####### not a heading</p>\n");
+}
+
+//======================== render cache ========================
+
+//a store in a temporary file, filled like labsindex applies deltas
+class test_store {
+    public:
+
+    test_store()
+        : _path((std::filesystem::temp_directory_path() / ("labstest-" + std::to_string(::getpid()) + ".store")).string()) {
+        std::filesystem::remove(_path);
+        _store.reset(new waxlabs_store::store(_path, size_t(16) << 20));
+        _store->set_contract(CONTRACT);
+    }
+
+    ~test_store() {
+        _store.reset();
+        std::filesystem::remove(_path);
+    }
+
+    waxlabs_store::store& get() { return *_store; }
+
+    void put_proposal(uint64_t proposal_id, uint32_t update_ts, std::string_view road_map) {
+        waxlabs_codec::proposal prop{};
+        prop.proposal_id = proposal_id;
+        prop.proposer = name("alice").value;
+        prop.status = 1;
+        prop.title = "title";
+        prop.update_ts = update_ts;
+        prop.road_map = road_map;
+        std::string packed;
+        waxlabs_codec::encode(prop, packed);
+        apply(waxlabs_store::PROPOSALS, proposal_id, true, packed);
+        log(waxlabs_store::PROPOSALS, proposal_id, 2);
+    }
+
+    void put_body(uint64_t proposal_id, std::string_view content) {
+        std::string packed;
+        waxlabs_codec::encode(waxlabs_codec::mdbody{proposal_id, content}, packed);
+        apply(waxlabs_render::MDBODIES, proposal_id, true, packed);
+        log(waxlabs_render::MDBODIES, proposal_id, 2);
+    }
+
+    void erase_proposal(uint64_t proposal_id) {
+        apply(waxlabs_store::PROPOSALS, proposal_id, false, "");
+        apply(waxlabs_render::MDBODIES, proposal_id, false, "");
+        log(waxlabs_store::PROPOSALS, proposal_id, waxlabs_render::CHANGE_ERASE);
+        log(waxlabs_render::MDBODIES, proposal_id, waxlabs_render::CHANGE_ERASE);
+    }
+
+    //drops the oldest changes entries, like the contract past CHANGE_RETENTION
+    void prune_changes(uint64_t below_seq) {
+        for (uint64_t seq = 0; seq < below_seq; seq++) {
+            apply(waxlabs_render::CHANGES, seq, false, "");
+        }
+    }
+
+    private:
+
+    static constexpr uint64_t CONTRACT = name("labs.wax").value;
+
+    void apply(uint64_t table, uint64_t primary_key, bool present, const std::string& packed) {
+        auto lock = _store->write_lock();
+        _store->begin_block();
+        _store->apply(table, CONTRACT, primary_key, present, packed.data(), packed.size());
+        _store->commit_block(++_block);
+    }
+
+    void log(uint64_t table, uint64_t key, uint8_t op) {
+        std::string packed;
+        waxlabs_codec::encode(waxlabs_codec::change{_seq, table, CONTRACT, key, op, 0}, packed);
+        apply(waxlabs_render::CHANGES, _seq++, true, packed);
+    }
+
+    std::string _path;
+    std::unique_ptr<waxlabs_store::store> _store;
+    uint32_t _block = 0;
+    uint64_t _seq = 0;
+};
+
+void test_cache() {
+    test_store ts;
+    auto& st = ts.get();
+    waxlabs_render::cache cache;
+
+    ts.put_proposal(1, 100, "- step one");
+    ts.put_body(1, "# Body <b>one</b>");
+    ts.put_proposal(2, 100, "");
+    CHECK(cache.get(st, 3) == nullptr);
+
+    //first request renders body and road map once, later ones are served from memory
+    cache.refresh(st);
+    const waxlabs_render::rendered* html = cache.get(st, 1);
+    CHECK(html != nullptr);
+    CHECK(html->update_ts == 100);
+    CHECK(html->body_html == "<h1>Body &lt;b&gt;one&lt;/b&gt;</h1>\n");
+    CHECK(html->road_map_html == "<ul>\n<li>step one</li>\n</ul>\n");
+    CHECK(cache.renders() == 2);
+    CHECK(cache.refresh(st) == 0);
+    cache.get(st, 1);
+    CHECK(cache.renders() == 2);
+    CHECK(cache.hits() == 1);
+
+    //a status change writes proposals with a new update_ts but the same inputs: no render
+    ts.put_proposal(1, 200, "- step one");
+    CHECK(cache.refresh(st) == 1);
+    html = cache.get(st, 1);
+    CHECK(html->update_ts == 200);
+    CHECK(cache.renders() == 2);
+
+    //a body edit renders the body again, the road map stays
+    ts.put_body(1, "new *body*");
+    ts.put_proposal(1, 300, "- step one");
+    cache.refresh(st);
+    html = cache.get(st, 1);
+    CHECK(html->body_html == "<p>new <em>body</em></p>\n");
+    CHECK(cache.renders() == 3);
+
+    //changes to proposals never requested don't touch the cache
+    ts.put_proposal(2, 300, "two");
+    CHECK(cache.refresh(st) == 0);
+
+    //an erased proposal is dropped
+    ts.erase_proposal(1);
+    CHECK(cache.refresh(st) == 1);
+    CHECK(cache.entries() == 0);
+    CHECK(cache.get(st, 1) == nullptr);
+
+    //entries pruned before the cache saw them: every entry is checked again
+    cache.get(st, 2);
+    uint64_t renders = cache.renders();
+    uint64_t unseen = cache.next_seq();
+    ts.put_body(2, "pruned edit");
+    ts.put_proposal(2, 400, "two");
+    ts.prune_changes(unseen + 1);
+    CHECK(cache.refresh(st) == 1);
+    CHECK(cache.get(st, 2)->body_html == "<p>pruned edit</p>\n");
+    CHECK(cache.renders() == renders + 1);
+}
+
+void test_size_limit() {
+    test_store ts;
+    auto& st = ts.get();
+    waxlabs_render::cache cache;
+
+    ts.put_proposal(1, 100, std::string(waxlabs_render::MAX_ROAD_MAP_LEN, 'r'));
+    ts.put_body(1, std::string(waxlabs_render::MAX_BODY_LEN, 'b'));
+    ts.put_proposal(2, 100, std::string(waxlabs_render::MAX_ROAD_MAP_LEN + 1, 'r'));
+    ts.put_body(2, std::string(waxlabs_render::MAX_BODY_LEN + 1, 'b'));
+    cache.refresh(st);
+
+    const waxlabs_render::rendered* at_limit = cache.get(st, 1);
+    CHECK(!at_limit->body_too_long && !at_limit->road_map_too_long);
+    CHECK(at_limit->body_html.size() == waxlabs_render::MAX_BODY_LEN + 8);
+
+    const waxlabs_render::rendered* over = cache.get(st, 2);
+    CHECK(over->body_too_long && over->body_html.empty());
+    CHECK(over->road_map_too_long && over->road_map_html.empty());
+}
+
+int main() {
+    try {
+        test_escape();
+        test_safe_url();
+        test_no_raw_html();
+        test_markdown();
+        test_cache();
+        test_size_limit();
+    } catch (const std::exception& e) {
+        std::cerr << "exception: " << e.what() << std::endl;
+        failures++;
+    }
+    std::printf("%d checks, %d failed\n", checks, failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,57 @@
+#! /bin/bash
+
+#contract, only waxlabs has a config migration
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#account
+account=$2
+
+#network
+if [[ "$3" == "mainnet" ]]; then
+    url=https://wax.greymass.com
+    network="WAX Mainnet"
+elif [[ "$3" == "testnet" ]]; then
+    url=https://testnet.waxsweden.org
+    network="WAX Testnet"
+elif [[ "$3" == "local" ]]; then
+    url=http://127.0.0.1:8888
+    network="Local"
+else
+    echo "need network"
+    exit 0
+fi
+
+# upgrades a contract holding a legacy config row. the new code reads that row with the wrong
+# layout, so setcode, setabi and migrateconf go out in one transaction (see docs/ContractAPI.md).
+# setcode and setabi sign with $account@deploy, migrateconf with $account@active.
+#
+# run this once, for the release that introduces the basis point thresholds. the chain refuses a
+# setcode with the code already deployed, so a failed or skipped run needs a new build to retry.
+# later releases deploy with deploy.sh.
+
+outdir=./build/upgrade
+mkdir -p $outdir
+
+echo ">>> Upgrading $contract contract on $account on $network with migrateconf..."
+
+#setcode and setabi, built without signing or sending
+cleos -u $url set contract $account ./build/ $contract.wasm $contract.abi -p $account@deploy -s -d -j -x 300 \
+    > $outdir/upgrade.json || exit 1
+
+#migrateconf after them, in the same transaction
+jq --arg account $account \
+    '.actions += [{"account": $account, "name": "migrateconf", "authorization": [{"actor": $account, "permission": "active"}], "data": ""}]' \
+    $outdir/upgrade.json > $outdir/upgrade_migrate.json || exit 1
+
+actions=$(jq -r '[.actions[].name] | join(", ")' $outdir/upgrade_migrate.json)
+if [[ "$actions" != "setcode, setabi, migrateconf" ]]; then
+    echo "unexpected upgrade transaction: $actions"
+    exit 1
+fi
+
+cleos -u $url push transaction $outdir/upgrade_migrate.json || exit 1
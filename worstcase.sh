@@ -0,0 +1,314 @@
+#! /bin/bash
+
+#contract
+if [[ "$1" == "waxlabs" ]]; then
+    contract=waxlabs
+else
+    echo "need contract"
+    exit 0
+fi
+
+#account
+account=$2
+
+#admin
+admin=$3
+
+#proposer
+proposer=$4
+
+#local network only
+url=http://127.0.0.1:8888
+network="Local"
+
+outdir=./build/worstcase
+results=$outdir/results.tsv
+failures=$outdir/failures.log
+worst_points=$outdir/worst.tsv
+baseline=${5:-$outdir/baseline.tsv}
+
+if [[ "$account" == "" || "$admin" == "" || "$proposer" == "" ]]; then
+    echo "usage: ./worstcase.sh waxlabs <account> <admin> <proposer> [baseline.tsv]"
+    exit 0
+fi
+
+echo ">>> Searching worst case CPU and RAM of $contract on $account ($network)..."
+
+# requires cleos, jq, an unlocked wallet holding the keys of eosio, <admin> and <proposer>,
+# and decidemock deployed to the decide account with a VOTE treasury (see README)
+# sets the vote duration to 1 second, run against a throwaway local chain only
+# creates a max size profile for <proposer> when it has none, and sets <admin> as reviewer of every proposal
+#
+# every string argument is at its on-chain maximum, unbounded memos and reports use MEMO_LEN.
+# actions that loop over deliverables are measured at each count in SIZES, up to MAX_DELIVERABLES.
+# each flow then keeps its worst count, the one with the highest summed CPU of its actions, and
+# measures the untried midpoints between it and its measured neighbours until they are adjacent,
+# so a peak between two grid counts is found and the worst point is measured at its exact count.
+#
+# results are written to $results, one line per action and size: action, deliverables, cpu_us, ram_bytes.
+# copy them to $outdir/baseline.tsv (or pass a baseline) to report regressions on the next run.
+# a failed push aborts its flow at that deliverable count, it is logged to $failures and listed in the report.
+
+MAX_TITLE_LEN=64
+MAX_DESCR_LEN=160
+MAX_BODY_LEN=4096
+MAX_IMGURL_LEN=256
+MAX_SMALL_DESC_LEN=80
+MAX_ROAD_MAP_LEN=2048
+MAX_PROFILE_NAME_LEN=64
+MAX_BIO_LEN=1024
+MAX_CONTACT_LEN=256
+MEMO_LEN=4096
+SIZES="1 5 10 20"
+
+#measured actions of each flow, a flow's cost at a count is the sum of their cpu
+FLOWS="cancel vote claim"
+declare -A flow_actions=(
+    [cancel]="draftprop newdeliv editprop submitprop reviewprop beginvoting cancelprop deleteprop"
+    [vote]="endvoting"
+    [claim]="skipvoting submitreport reviewdeliv claimfunds"
+)
+
+#"flow count" pairs already run, a count is never run twice for a flow
+declare -A measured
+
+mkdir -p $outdir
+: > $results
+: > $failures
+: > $worst_points
+
+#string of n characters
+fill() {
+    head -c $1 < /dev/zero | tr '\0' 'x'
+}
+
+title=$(fill $MAX_TITLE_LEN)
+descr=$(fill $MAX_DESCR_LEN)
+body=$(fill $MAX_BODY_LEN)
+imgurl=$(fill $MAX_IMGURL_LEN)
+smalldesc=$(fill $MAX_SMALL_DESC_LEN)
+roadmap=$(fill $MAX_ROAD_MAP_LEN)
+memo=$(fill $MEMO_LEN)
+
+#pushes one action, records its cost when a label is given and prints the trace
+#a failure is appended to $failures with the first line of the chain error
+push() {
+    local label=$1
+    local size=$2
+    local code=$3
+    local act=$4
+    local data=$5
+    local auth=$6
+    local out
+    if ! out=$(cleos -u $url push action $code $act "$data" -p $auth -j 2> $outdir/error.txt); then
+        echo -e "$act\t$size\t$(grep -m1 -i "error\|assert" $outdir/error.txt)" >> $failures
+        echo "$act failed" >&2
+        return 1
+    fi
+    if [[ "$label" != "" ]]; then
+        echo -e "$label\t$size\t$(echo "$out" | jq -r '.processed.receipt.cpu_usage_us')\t$(echo "$out" \
+            | jq '[.processed.action_traces[].account_ram_deltas[].delta] | add // 0')" >> $results
+    fi
+    echo "$out"
+}
+
+#unique ballot name per proposal
+ballot_name() {
+    echo "wcb$(echo $1 | tr '0-9' 'a-j')"
+}
+
+#drafts a max size proposal with n deliverables and leaves it in drafting, prints its id
+draft() {
+    local n=$1
+    local label=$2
+    local out id
+    push "" $n eosio.token transfer "[\"eosio\", \"$proposer\", \"200.00000000 WAX\", \"\"]" eosio > /dev/null || return 1
+    push "" $n eosio.token transfer "[\"$proposer\", \"$account\", \"200.00000000 WAX\", \"\"]" $proposer > /dev/null || return 1
+    out=$(push "$label" $n $account draftprop \
+        "[\"$title\", \"$descr\", \"$body\", \"$proposer\", \"$imgurl\", 30, \"other\", \"$roadmap\"]" $proposer) || return 1
+    id=$(echo "$out" | jq -r '.processed.action_traces[0].return_value_data.proposal_id // empty')
+    if [[ "$id" == "" ]]; then
+        #builds without action return values, the new proposal has the highest id
+        id=$(cleos -u $url get table $account $account proposals -r -l 1 | jq -r '.rows[0].proposal_id')
+    fi
+    for d in $(seq 1 $n); do
+        local newdeliv_label=""
+        [[ $d -eq $n && "$label" != "" ]] && newdeliv_label=newdeliv
+        push "$newdeliv_label" $d $account newdeliv \
+            "[$id, $d, \"1000.00000000 WAX\", \"$proposer\", \"$smalldesc\", 10]" $proposer > /dev/null || return 1
+    done
+    echo $id
+}
+
+#cancel from voting, which also cancels the ballot, then delete
+cancel_flow() {
+    local n=$1
+    local id
+    id=$(draft $n draftprop) || return 1
+    push editprop $n $account editprop \
+        "[$id, \"$title\", \"$descr\", \"$(fill $((MAX_BODY_LEN - 1)))y\", \"other\", \"$imgurl\", 30, \"$roadmap\"]" $proposer > /dev/null || return 1
+    push submitprop $n $account submitprop "[$id]" $proposer > /dev/null || return 1
+    push "" $n $account setreviewer "[$id, 0, \"$admin\"]" $admin > /dev/null || return 1
+    push reviewprop $n $account reviewprop "[$id, true, \"$memo\"]" $admin > /dev/null || return 1
+    push beginvoting $n $account beginvoting "[$id, \"$(ballot_name $id)\"]" $proposer > /dev/null || return 1
+    push cancelprop $n $account cancelprop "[$id, \"$memo\"]" $proposer > /dev/null || return 1
+    push deleteprop $n $account deleteprop "[$id]" $proposer > /dev/null
+}
+
+#pass a vote, endvoting includes closevoting and catch_broadcast
+vote_flow() {
+    local n=$1
+    local id
+    id=$(draft $n) || return 1
+    push "" $n $account submitprop "[$id]" $proposer > /dev/null || return 1
+    push "" $n $account setreviewer "[$id, 0, \"$admin\"]" $admin > /dev/null || return 1
+    push "" $n $account reviewprop "[$id, true, \"\"]" $admin > /dev/null || return 1
+    push "" $n $account beginvoting "[$id, \"$(ballot_name $id)\"]" $proposer > /dev/null || return 1
+    push "" $n decide setresults \
+        "[\"$(ballot_name $id)\", [{\"key\": \"yes\", \"value\": \"1000000.00000000 VOTE\"}], 1]" decide > /dev/null || return 1
+    sleep 2
+    push endvoting $n $account endvoting "[$id]" $proposer > /dev/null
+}
+
+#skip voting, then run one deliverable through to the last claim
+claim_flow() {
+    local n=$1
+    local id label
+    id=$(draft $n) || return 1
+    push "" $n $account submitprop "[$id]" $proposer > /dev/null || return 1
+    push "" $n $account setreviewer "[$id, 0, \"$admin\"]" $admin > /dev/null || return 1
+    push skipvoting $n $account skipvoting "[$id, \"$memo\"]" $admin > /dev/null || return 1
+    for d in $(seq 1 $n); do
+        label=""
+        [[ $d -eq $n ]] && label=last
+        push "${label:+submitreport}" $n $account submitreport "[$id, $d, \"$memo\"]" $proposer > /dev/null || return 1
+        push "${label:+reviewdeliv}" $n $account reviewdeliv "[$id, $d, true, \"$memo\"]" $admin > /dev/null || return 1
+        push "${label:+claimfunds}" $n $account claimfunds "[$id, $d]" $proposer > /dev/null || return 1
+    done
+}
+
+#runs a flow at a deliverable count once, failures are logged and the count stays measured
+run_flow() {
+    local flow=$1
+    local n=$2
+    [[ -n "${measured[$flow $n]}" ]] && return
+    measured[$flow $n]=1
+    ${flow}_flow $n || echo -e "$flow flow\t$n\taborted" >> $failures
+}
+
+#summed cpu of a flow's measured actions at a deliverable count
+flow_cpu() {
+    awk -F'\t' -v n=$2 -v actions=" ${flow_actions[$1]} " 'index(actions, " " $1 " ") && $2 == n { sum += $3 } END { print sum + 0 }' $results
+}
+
+#deliverable counts a flow was run at, ascending
+measured_sizes() {
+    local key
+    for key in "${!measured[@]}"; do
+        [[ "$key" == "$1 "* ]] && echo ${key#* }
+    done | sort -n
+}
+
+#moves to the worst measured count and runs the midpoints towards its neighbours until none is left
+refine() {
+    local flow=$1
+    local sizes i w cpu best worst lo hi mid progress
+    while true; do
+        sizes=($(measured_sizes $flow))
+        best=-1
+        for i in ${!sizes[@]}; do
+            cpu=$(flow_cpu $flow ${sizes[$i]})
+            if (( cpu > best )); then
+                best=$cpu
+                w=$i
+            fi
+        done
+        worst=${sizes[$w]}
+        lo=$worst
+        hi=$worst
+        (( w > 0 )) && lo=${sizes[$((w - 1))]}
+        (( w + 1 < ${#sizes[@]} )) && hi=${sizes[$((w + 1))]}
+
+        progress=0
+        for mid in $(( (lo + worst) / 2 )) $(( (worst + hi + 1) / 2 )); do
+            if [[ -z "${measured[$flow $mid]}" ]]; then
+                echo ">>> refining $flow flow at $mid deliverables..."
+                run_flow $flow $mid
+                progress=1
+            fi
+        done
+        [[ $progress == 0 ]] && break
+    done
+    echo -e "$flow\t$worst\t$best\t${sizes[*]}" >> $worst_points
+}
+
+#vote duration of one second so endvoting can run right away
+cleos -u $url push action $account setduration '[1]' -p $admin > /dev/null
+cleos -u $url push action eosio.token transfer "[\"eosio\", \"$account\", \"1000000.00000000 WAX\", \"fund\"]" -p eosio > /dev/null
+
+#max size profile for the proposer, draftprop requires one
+if [[ $(cleos -u $url get table $account $account profileregs -L $proposer -U $proposer | jq '.rows | length') == "0" ]]; then
+    push newprofile 0 $account newprofile "[\"$proposer\", \"$(fill $MAX_PROFILE_NAME_LEN)\", \"$(fill $MAX_PROFILE_NAME_LEN)\", \
+        \"$(fill $MAX_BIO_LEN)\", \"$imgurl\", \"$imgurl\", \"$(fill $MAX_CONTACT_LEN)\", \"$(fill $MAX_PROFILE_NAME_LEN)\"]" $proposer > /dev/null \
+        || { echo "cannot create the proposer profile, see $failures"; exit 1; }
+fi
+
+for n in $SIZES; do
+    echo ">>> $n deliverables..."
+    for flow in $FLOWS; do
+        run_flow $flow $n
+    done
+done
+
+for flow in $FLOWS; do
+    refine $flow
+done
+
+#report
+report=$outdir/report.md
+
+echo "# $contract worst case report" > $report
+echo "" >> $report
+echo "| action | worst at deliverables | cpu us | ram bytes | baseline cpu us | baseline ram bytes |" >> $report
+echo "|---|---|---|---|---|---|" >> $report
+for action in $(cut -f1 $results | sort -u); do
+    worst=$(grep -P "^$action\t" $results | sort -t$'\t' -k3 -n | tail -1)
+    size=$(echo "$worst" | cut -f2)
+    if [[ -f $baseline ]]; then
+        base=$(grep -P "^$action\t$size\t" $baseline | head -1)
+    else
+        base=""
+    fi
+    echo "| $action | $size | $(echo "$worst" | cut -f3) | $(echo "$worst" | cut -f4) | $(echo "$base" | cut -f3) | $(echo "$base" | cut -f4) |" >> $report
+done
+
+echo "" >> $report
+echo "## Worst point per flow" >> $report
+echo "" >> $report
+echo "| flow | worst at deliverables | flow cpu us | measured deliverable counts |" >> $report
+echo "|---|---|---|---|" >> $report
+awk -F'\t' '{ print "| " $1 " | " $2 " | " $3 " | " $4 " |" }' $worst_points >> $report
+
+echo "" >> $report
+echo "## By deliverable count" >> $report
+echo "" >> $report
+echo "| action | deliverables | cpu us | ram bytes |" >> $report
+echo "|---|---|---|---|" >> $report
+sort -t$'\t' -k1,1 -k2,2n $results | awk -F'\t' '{ print "| " $1 " | " $2 " | " $3 " | " $4 " |" }' >> $report
+
+#failed pushes leave their actions unmeasured at that count, so the run is not a valid baseline
+if [[ -s $failures ]]; then
+    echo "" >> $report
+    echo "## Failed pushes" >> $report
+    echo "" >> $report
+    echo "| action or flow | deliverables | error |" >> $report
+    echo "|---|---|---|" >> $report
+    awk -F'\t' '{ print "| " $1 " | " $2 " | " $3 " |" }' $failures >> $report
+fi
+
+cat $report
+
+if [[ -s $failures ]]; then
+    echo ">>> $(grep -vc "aborted$" $failures) pushes failed, do not use these results as a baseline"
+    exit 1
+fi